@@ -2,286 +2,89 @@
 #include <unordered_map>
 #include <vector>
 #include <string>
-#include <queue>
 #include <limits>
 #include <random>
 #include <algorithm>
 #include <iomanip>
 #include <chrono>
 #include <cmath>
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-#include "tinyxml2.h"
+#include "graph.h"
+#include "search.h"
 
-using namespace tinyxml2;
 using namespace std;
 
-/* ================================
-   Node :   ׷ 
-   - id :  ȣ
-   - lat/lon : /浵
-   ================================ */
-struct Node {
-    string id;
-    double lat = 0.0;
-    double lon = 0.0;
-};
-
-/* ================================
-   EdgeInfo :  
-   - length : Ÿ ()
-   - roadName : θ
-   ================================ */
-struct EdgeInfo {
-    double length = 0.0;
-    string roadName;
-};
-
 /* ================================
     ׷ 
    ================================ */
-unordered_map<string, Node> nodes;                               //  
-unordered_map<string, vector<pair<string, double>>> adj;          // Ʈ: id  (̿, )
-unordered_map<string, unordered_map<string, EdgeInfo>> edgeInfoMap; //   
-unordered_map<string, string> keyIdToName;                        // GraphML key id  field name (d4 = lat )
-
-static constexpr double R = 6371000.0; //  ()
-
-/* =========================================================
-   Haversine Ÿ  (lat/lon  meter)
-   ========================================================= */
-double haversine(double lat1, double lon1, double lat2, double lon2) {
-    auto rad = [](double d) { return d * M_PI / 180.0; };
-    double dlat = rad(lat2 - lat1), dlon = rad(lon2 - lon1);
-    double a = sin(dlat / 2) * sin(dlat / 2)
-        + cos(rad(lat1)) * cos(rad(lat2)) * sin(dlon / 2) * sin(dlon / 2);
-    return 2 * R * atan2(sqrt(a), sqrt(1 - a));
-}
-
-/* =========================================================
-   XML ± ̸ namespace  (node, edge  )
-   ========================================================= */
-string localName(const char* name) {
-    if (!name) return "";
-    string s = name;
-    size_t p = s.find_last_of(":}");
-    return (p != string::npos) ? s.substr(p + 1) : s;
-}
+Graph graph;               // CSR ׷ (//θ)
+SearchWorkspace workspace; //   Ǵ Ž 
 
 /* =========================================================
    GraphML  ε
-   - d4 = latitude
-   - d5 = longitude
-   - d16 = length
-   - d13 = road name
    ========================================================= */
 bool loadGraphML(const string& file) {
-    XMLDocument doc;
-    if (doc.LoadFile(file.c_str()) != XML_SUCCESS) return false;
-    XMLElement* root = doc.RootElement();
-    if (!root) return false;
-
-    // 1) <key> ± о keyIdToName 
-    for (auto* key = root->FirstChildElement(); key; key = key->NextSiblingElement()) {
-        if (localName(key->Name()) != "key") continue;
-        const char* id = key->Attribute("id");
-        const char* attr = key->Attribute("attr.name");
-        if (id && attr) keyIdToName[id] = attr;
-    }
-
-    // 2) <graph> ± ã
-    XMLElement* graph = nullptr;
-    for (auto* c = root->FirstChildElement(); c; c = c->NextSiblingElement()) {
-        if (localName(c->Name()) == "graph") graph = c;
-    }
-    if (!graph) graph = root; // fallback
-
-    // 3)  Ľ
-    for (auto* n = graph->FirstChildElement(); n; n = n->NextSiblingElement()) {
-        if (localName(n->Name()) != "node") continue;
-
-        const char* id = n->Attribute("id");
-        if (!id) continue;
-
-        Node nd; nd.id = id;
-
-        for (auto* d = n->FirstChildElement(); d; d = d->NextSiblingElement()) {
-            if (localName(d->Name()) != "data") continue;
-            const char* key = d->Attribute("key");
-            const char* text = d->GetText();
-            if (!key || !text) continue;
-
-            string attr = keyIdToName[key];
-            double v = atof(text);
-
-            if (attr == "lat" || attr == "y" || key == string("d4"))
-                nd.lat = v;
-            else if (attr == "lon" || attr == "x" || key == string("d5"))
-                nd.lon = v;
-        }
-        nodes[id] = nd;
-        adj[id]; //  Ʈ ʱȭ
-    }
-
-    // 4)  Ľ
-    for (auto* e = graph->FirstChildElement(); e; e = e->NextSiblingElement()) {
-        if (localName(e->Name()) != "edge") continue;
-
-        const char* s = e->Attribute("source");
-        const char* t = e->Attribute("target");
-        if (!s || !t) continue;
-
-        double length = NAN;
-        string road;
-        string oneway;
-
-        //  data Ľ
-        for (auto* d = e->FirstChildElement(); d; d = d->NextSiblingElement()) {
-            if (localName(d->Name()) != "data") continue;
-
-            const char* key = d->Attribute("key");
-            const char* text = d->GetText();
-            if (!key || !text) continue;
-
-            string attr = keyIdToName[key];
-
-            if (attr == "length" || key == string("d16"))
-                length = atof(text);
-            else if (attr == "name" || key == string("d13"))
-                road = text;
-            else if (attr == "oneway")
-                oneway = text;
-        }
-
-        // 4-1)   浵  
-        if (!isfinite(length)) {
-            if (nodes.count(s) && nodes.count(t))
-                length = haversine(nodes[s].lat, nodes[s].lon, nodes[t].lat, nodes[t].lon);
-            else length = 0.0;
-        }
-
-        // 4-2) ⼺ ó (oneway true ܹ)
-        bool isOne = false;
-        if (!oneway.empty()) {
-            string v = oneway;
-            transform(v.begin(), v.end(), v.begin(), ::tolower);
-            if (v == "true" || v == "yes" || v == "1") isOne = true;
-        }
-
-        // Ʈ   
-        adj[s].push_back({ t, length });
-        edgeInfoMap[s][t] = { length, road };
-
-        if (!isOne) {
-            adj[t].push_back({ s, length });
-            edgeInfoMap[t][s] = { length, road };
-        }
-    }
-    return true;
+    return loadGraphML(file, graph);
 }
 
 /* =========================================================
     Է (lat, lon)    ã
    -  Ÿ : 20m
    ========================================================= */
-string findNode(double lat, double lon) {
-    string best = "";
+uint32_t findNode(double lat, double lon) {
+    uint32_t best = INVALID_NODE;
     double minD = 1e18;
 
-    for (auto& kv : nodes) {
-        const Node& n = kv.second;
-        double d = haversine(lat, lon, n.lat, n.lon);
-        if (d < minD) { minD = d; best = n.id; }
+    for (uint32_t u = 0; u < graph.numNodes(); u++) {
+        double d = haversine(lat, lon, graph.lat[u], graph.lon[u]);
+        if (d < minD) { minD = d; best = u; }
     }
-    return (minD <= 20.0) ? best : "";
+    return (minD <= 20.0) ? best : INVALID_NODE;
 }
 
 /* =========================================================
       ( Ʈ  ü Ÿ)
    ========================================================= */
-double pathLength(const vector<string>& p) {
-    double sum = 0;
-    for (size_t i = 1; i < p.size(); i++)
-        sum += edgeInfoMap[p[i - 1]][p[i]].length;
-    return sum;
+double pathLength(const vector<uint32_t>& p) {
+    return pathLength(graph, p);
 }
 
 /* =========================================================
    Dijkstra ִ  ˰
    ========================================================= */
-vector<string> dijkstra(const string& start, const string& goal) {
-    unordered_map<string, double> dist;
-    unordered_map<string, string> prev;
-
-    // Ÿ ʱȭ
-    for (auto& kv : nodes) dist[kv.first] = 1e18;
-    dist[start] = 0;
-
-    // ּ 
-    priority_queue<pair<double, string>,
-        vector<pair<double, string>>,
-        greater<>> pq;
-
-    pq.push({ 0, start });
-
-    while (!pq.empty()) {
-        auto [cd, u] = pq.top();
-        pq.pop();
-
-        if (u == goal) break;
-
-        for (auto& pr : adj[u]) {
-            string v = pr.first;
-            double w = pr.second;
+vector<uint32_t> dijkstra(uint32_t start, uint32_t goal) {
+    vector<uint32_t> path;
+    if (dijkstra(graph, workspace, start, goal) >= INF_DIST) return path; //   Ұ
 
-            if (dist[v] > cd + w) {
-                dist[v] = cd + w;
-                prev[v] = u;
-                pq.push({ dist[v], v });
-            }
-        }
-    }
-
-    //   Ұ
-    if (dist[goal] >= 1e18) return {};
-
-    //  
-    vector<string> path;
-    for (string cur = goal; ; cur = prev[cur]) {
-        path.push_back(cur);
-        if (cur == start) break;
-    }
-    reverse(path.begin(), path.end());
+    workspace.path(goal, path);
     return path;
 }
 
 /* =========================================================
    Monte Carlo Random Path Sampling
    ========================================================= */
-vector<string> monteCarlo(const string& start, const string& goal, int M, int N) {
+vector<uint32_t> monteCarlo(uint32_t start, uint32_t goal, int M, int N) {
     //   õ
     mt19937_64 rng(
         chrono::high_resolution_clock::now().time_since_epoch().count()
     );
 
-    vector<string> best;
+    vector<uint32_t> best;
     int bestStep = 1e9;
     double bestLen = 1e18;
 
     // M ݺ 
     for (int i = 0; i < M; i++) {
-        vector<string> path = { start };
-        string cur = start;
+        vector<uint32_t> path = { start };
+        uint32_t cur = start;
 
         // N ܱ  Ž
         for (int st = 0; st < N; st++) {
             if (cur == goal) break;
-            auto& nb = adj[cur];
-            if (nb.empty()) break;
+            uint32_t deg = graph.degree(cur);
+            if (deg == 0) break;
 
-            uniform_int_distribution<int> pick(0, nb.size() - 1);
-            string nxt = nb[pick(rng)].first;
+            uniform_int_distribution<int> pick(0, deg - 1);
+            uint32_t nxt = graph.target[graph.edgeBegin(cur) + pick(rng)];
 
             path.push_back(nxt);
             cur = nxt;
@@ -304,13 +107,8 @@ vector<string> monteCarlo(const string& start, const string& goal, int M, int N)
 /* =========================================================
    ¿ :  path  "a-b-c-d" ڿ
    ========================================================= */
-string toDash(const vector<string>& p) {
-    string s;
-    for (size_t i = 0; i < p.size(); i++) {
-        s += p[i];
-        if (i + 1 < p.size()) s += "-";
-    }
-    return s;
+string toDash(const vector<uint32_t>& p) {
+    return toDash(graph, p);
 }
 
 /* =========================================================
@@ -332,10 +130,10 @@ int main() {
     cin >> dlat >> dlon;
 
     //  Ī
-    string s = findNode(slat, slon);
-    string d = findNode(dlat, dlon);
+    uint32_t s = findNode(slat, slon);
+    uint32_t d = findNode(dlat, dlon);
 
-    if (s.empty() || d.empty()) {
+    if (s == INVALID_NODE || d == INVALID_NODE) {
         cout << "Node not found\n";
         return 0;
     }
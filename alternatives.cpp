@@ -0,0 +1,170 @@
+#include "alternatives.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+// u  v      
+uint32_t cheapestEdge(const Graph& g, Span<double> weight, uint32_t u, uint32_t v) {
+    uint32_t best = INVALID_EDGE;
+    for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++)
+        if (g.target[e] == v && (best == INVALID_EDGE || weight[e] < weight[best])) best = e;
+    return best;
+}
+
+/* -----------------------------------------
+   ִ  Ʈ (limit  Ѵ   )
+   - backward   CSR  root  , prev = root   
+   - order : Ȯ  ( )
+   - goal    limit =   * (1 + stretch)   (goal   INVALID_NODE)
+   ----------------------------------------- */
+double growTree(const Graph& g, SearchWorkspace& ws, uint32_t root, Span<double> weight, bool backward,
+                double limit, uint32_t goal, double stretch, vector<uint32_t>& order) {
+    if (ws.size() != g.numNodes()) ws.resize(g.numNodes());
+    ws.reset();
+    order.clear();
+    auto& pq = ws.queue;
+    ws.set(root, 0, INVALID_NODE);
+    pq.push(root, 0);
+    while (!pq.empty()) {
+        auto [cd, u] = pq.pop();
+        if (cd > ws.dist(u)) continue;
+        if (cd > limit) break;
+        if (u == goal) limit = cd * (1 + stretch);
+        order.push_back(u);
+        if (!backward) {
+            for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+                uint32_t v = g.target[e];
+                double nd = cd + weight[e];
+                if (ws.dist(v) > nd) { ws.set(v, nd, u); pq.push(v, nd); }
+            }
+        } else {
+            for (uint32_t k = g.inBegin(u); k < g.inEnd(u); k++) {
+                uint32_t v = g.rSource[k];
+                double nd = cd + weight[g.rEdge[k]];
+                if (ws.dist(v) > nd) { ws.set(v, nd, u); pq.push(v, nd); }
+            }
+        }
+    }
+    return limit;
+}
+
+} // namespace
+
+/* =========================================================
+     Ž
+   1)  Ʈ (  = (1 + maxStretch) * ִ ,  Ʈ goal    )
+   2) plateau  :  θ  u  v   Ʈ  (bwd.prev(u) == v) 
+        pf(v) =   ̾  ,  pb(v) =  ,  plateau(v) = pf + pb
+   3) ĺ plateau   ˻
+   ========================================================= */
+size_t alternativeRoutes(const Graph& g, AlternativeWorkspace& ws, uint32_t start, uint32_t goal,
+                         Span<double> weight, const AlternativeOptions& opt, vector<AlternativeRoute>& out) {
+    out.clear();
+    uint32_t n = g.numNodes();
+    auto& F = ws.fwd;
+    auto& B = ws.bwd;
+
+    if (opt.k == 0) return 0;
+    if (start == goal) { //  =  :  0  ϳ ( )
+        out.push_back({ { start }, 0.0, 1.0, INVALID_NODE });
+        return 1;
+    }
+    double limit = growTree(g, F, start, weight, false, INF_DIST, goal, opt.maxStretch, ws.settled);
+    if (!F.reached(goal)) return 0;
+    double best = F.dist(goal);
+    growTree(g, B, goal, weight, true, limit, INVALID_NODE, 0, ws.settledB);
+
+    // plateau  (Ȯ  )
+    ws.plateau.assign(n, 0.0);
+    vector<double> back(n, 0.0);
+    for (uint32_t v : ws.settled) {
+        uint32_t u = F.prev(v);
+        if (u != INVALID_NODE && B.reached(u) && B.prev(u) == v) back[v] = back[u] + (F.dist(v) - F.dist(u));
+    }
+    for (uint32_t v : ws.settledB) {
+        uint32_t x = B.prev(v);
+        if (x != INVALID_NODE && F.reached(x) && F.prev(x) == v)
+            ws.plateau[v] = ws.plateau[x] + (B.dist(v) - B.dist(x));
+    }
+    vector<uint32_t> cand;
+    for (uint32_t v : ws.settled) {
+        if (!B.reached(v) || F.dist(v) + B.dist(v) > limit) continue;
+        ws.plateau[v] += back[v];
+        cand.push_back(v);
+    }
+    sort(cand.begin(), cand.end(), [&](uint32_t a, uint32_t b) {
+        if (ws.plateau[a] != ws.plateau[b]) return ws.plateau[a] > ws.plateau[b];
+        return F.dist(a) + B.dist(a) < F.dist(b) + B.dist(b);
+    });
+
+    if (ws.used.size() != g.numEdges()) ws.used.assign(g.numEdges(), 0);
+    if (ws.seen.size() != n) { ws.seen.assign(n, 0); ws.stamp = 0; }
+    vector<uint32_t> markedEdges;
+
+    auto accept = [&](vector<uint32_t>&& path, double cost, double share, uint32_t via) {
+        for (size_t i = 1; i < path.size(); i++) {
+            uint32_t e = cheapestEdge(g, weight, path[i - 1], path[i]);
+            if (!ws.used[e]) { ws.used[e] = 1; markedEdges.push_back(e); }
+        }
+        out.push_back({ move(path), cost, share, via });
+    };
+
+    vector<uint32_t> path;
+    F.path(goal, path);
+    accept(move(path), best, 1.0, INVALID_NODE);
+
+    vector<double> prefix;
+    unsigned checks = 0;
+    for (uint32_t v : cand) {
+        if (out.size() >= opt.k || checks >= opt.maxChecks) break;
+        if (F.prev(v) != INVALID_NODE) {
+            uint32_t e = cheapestEdge(g, weight, F.prev(v), v);
+            if (e != INVALID_EDGE && ws.used[e] && B.prev(v) != INVALID_NODE) {
+                uint32_t f = cheapestEdge(g, weight, v, B.prev(v));
+                if (f != INVALID_EDGE && ws.used[f]) continue; // ̹   Ѱ
+            }
+        }
+
+        // via   + ߺ  ˻
+        path.clear();
+        F.path(v, path);
+        size_t iv = path.size() - 1;
+        for (uint32_t x = B.prev(v); x != INVALID_NODE; x = B.prev(x)) path.push_back(x);
+        if (++ws.stamp == 0) { fill(ws.seen.begin(), ws.seen.end(), 0); ws.stamp = 1; }
+        bool simple = true;
+        for (uint32_t x : path) {
+            if (ws.seen[x] == ws.stamp) { simple = false; break; }
+            ws.seen[x] = ws.stamp;
+        }
+        if (!simple) continue;
+
+        // ħ ,  
+        double shared = 0;
+        prefix.assign(path.size(), 0.0);
+        for (size_t i = 1; i < path.size(); i++) {
+            uint32_t e = cheapestEdge(g, weight, path[i - 1], path[i]);
+            prefix[i] = prefix[i - 1] + weight[e];
+            if (ws.used[e]) shared += weight[e];
+        }
+        double cost = prefix.back();
+        if (cost > limit || shared > opt.maxShare * best) continue;
+
+        // T-test : v յ  x  y  ִ
+        checks++;
+        double half = 0.5 * opt.localOpt * best;
+        size_t ix = iv, iy = iv;
+        while (ix > 0 && prefix[iv] - prefix[ix] < half) ix--;
+        while (iy + 1 < path.size() && prefix[iy] - prefix[iv] < half) iy++;
+        double segment = prefix[iy] - prefix[ix];
+        double direct = dijkstra(g, ws.local, path[ix], path[iy], [&](uint32_t, uint32_t e) { return weight[e]; });
+        if (direct < segment - 1e-9 * max(1.0, segment)) continue;
+
+        accept(vector<uint32_t>(path), cost, best > 0 ? shared / best : 1.0, v);
+    }
+
+    for (uint32_t e : markedEdges) ws.used[e] = 0;
+    return out.size();
+}
@@ -0,0 +1,50 @@
+/*
+ alternatives.h :   (via-node + plateau )
+  - s  , t   ִ  Ʈ (1 + maxStretch) * ִ  Ű
+  -  Ʈ   ϴ (plateau)  ڿ    ͺ via  ĺ
+  - ĺ v   = s  v ( Ʈ) + v  t ( Ʈ),   ϸ ä
+      1)   (1 + maxStretch) * ִ 
+      2) ̹  ε ġ   maxShare * ִ 
+      3)   : v յ localOpt * ִ  / 2   ü ִ  (T-test)
+      4)  带    
+  -  : Dijkstra   + ä ˻ ª Dijkstra   ( ȱ õ  )
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "graph.h"
+#include "search.h"
+
+struct AlternativeOptions {
+    unsigned k = 3;           // ִ   ִ  
+    double maxStretch = 0.25; // ִ    ʰ 
+    double maxShare = 0.6;    //  ε ĥ  ִ  
+    double localOpt = 0.25;   // T-test   (ִ  )
+    unsigned maxChecks = 64;  // T-test   ִ ĺ 
+};
+
+struct AlternativeRoute {
+    std::vector<uint32_t> path;
+    double cost;
+    double share; // ռ  ε ģ  / ִ  (ִ δ 1)
+    uint32_t via; // via  (ִ δ INVALID_NODE)
+};
+
+/* ================================
+   AlternativeWorkspace :    
+   ================================ */
+struct AlternativeWorkspace {
+    SearchWorkspace fwd, bwd, local;
+    std::vector<uint8_t> used;       //  ȣ   ο 
+    std::vector<uint32_t> seen;      //  ȣ  ߺ ˻ stamp
+    uint32_t stamp = 0;
+    std::vector<uint32_t> settled;   //  Ʈ Ȯ 
+    std::vector<uint32_t> settledB;  //  Ʈ Ȯ 
+    std::vector<double> plateau;     //  ȣ   plateau 
+};
+
+// out[0]  ִ ,  ä  (ȯ :  ,  Ұ 0)
+size_t alternativeRoutes(const Graph& g, AlternativeWorkspace& ws, uint32_t start, uint32_t goal,
+                         Span<double> weight, const AlternativeOptions& opt, std::vector<AlternativeRoute>& out);
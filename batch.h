@@ -0,0 +1,125 @@
+/*
+ batch.h :  (, )   Ǯ  óϴ   API
+  - ׷ б  , ۾ 帶 ڱ Ž ۾ (RouteWorker) 
+  -  û   (out[i]  reqs[i])
+  -  Լ  忡 ÿ ҸǷ б⸸ ؾ 
+  - δ ۾ 庰 PathPool  ̾ ̰  (, )  
+     Ǹ vector  Ҵ ,  run()  path(result)  
+  - useCache(cache, epoch) :  (, )  RouteCache  
+       ̸ epoch  ȣڰ   ϳ
+      dijkstraLive(reqs, out, state)  epoch   version  ٲ   ŵ  Žϸ   ȿ
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "cache.h"
+#include "graph.h"
+#include "live.h"
+#include "parallel.h"
+#include "pool.h"
+#include "search.h"
+
+struct RouteRequest {
+    uint32_t start, goal;
+};
+
+struct RouteResult {
+    double cost = INF_DIST;       //  Ұ INF_DIST
+    PathRef path;                 // θ û ʾ  0
+    uint32_t worker = 0;          // path   ִ ۾  Ǯ
+};
+
+// 庰 Ž  (ܹ / ) +  Ǯ
+struct RouteWorker {
+    SearchWorkspace search;
+    BidirectionalWorkspace bidir;
+    std::vector<uint32_t> path;   // ǰ ä  (run()  paths  ű)
+    PathPool paths;
+};
+
+/* ================================
+   BatchRouter
+   - run(reqs, out, query, withPath) : query(worker, req, result)  û ȣ ( û =  )
+     query  r.cost  ϰ withPath  w.path  ä (ĳô withPath   ִ ׸ )
+   - dijkstra(reqs, out, cost) : û Dijkstra
+   - dijkstraLive(reqs, out, state) :    Dijkstra (ĳ epoch = state->version)
+   - path(result) :   ( ȣ Span,   toDash)
+   - ) CH : router.run(reqs, out, [&](RouteWorker& w, const RouteRequest& q, RouteResult& r) {
+                  r.cost = chQuery(ch, w.bidir, q.start, q.goal);
+                  if (r.cost < INF_DIST) chPath(ch, w.bidir, w.path); });
+   ================================ */
+class BatchRouter {
+public:
+    explicit BatchRouter(const Graph& g, unsigned threads = 0) : g(g), pool(threads), workers(pool.size()) {
+        for (auto& w : workers) {
+            w.search.resize(g.numNodes());
+            w.bidir.fwd.resize(g.numNodes());
+            w.bidir.bwd.resize(g.numNodes());
+        }
+    }
+
+    unsigned threads() const { return pool.size(); }
+
+    //  ĳ  (nullptr ̸ ), ĳÿ     query /  Լ 
+    //  θ Žϸ epoch  dijkstraLive(reqs, out, state)  
+    void useCache(RouteCache* c, uint64_t epoch = 0) {
+        cache = c;
+        cacheEpoch = epoch;
+    }
+
+    Span<uint32_t> path(const RouteResult& r) const {
+        return Span<uint32_t>(workers[r.worker].paths.data(r.path), r.path.size);
+    }
+
+    template <class Query>
+    void run(const std::vector<RouteRequest>& reqs, std::vector<RouteResult>& out, Query&& query, bool withPath = true) {
+        out.resize(reqs.size());
+        for (auto& w : workers) w.paths.clear(); // 뷮    Ը ̸ Ҵ 
+        pool.parallelFor(reqs.size(), [&](unsigned tid, size_t i) {
+            RouteResult& r = out[i];
+            RouteWorker& w = workers[tid];
+            r.cost = INF_DIST;
+            r.path = PathRef();
+            r.worker = tid;
+            if (reqs[i].start >= g.numNodes() || reqs[i].goal >= g.numNodes()) return;
+            w.path.clear();
+            if (!cache || !cache->lookup(reqs[i].start, reqs[i].goal, cacheEpoch, r.cost, withPath ? &w.path : nullptr)) {
+                query(w, reqs[i], r);
+                if (cache) cache->insert(reqs[i].start, reqs[i].goal, cacheEpoch, r.cost, w.path, withPath);
+            }
+            if (!w.path.empty()) r.path = w.paths.add(w.path);
+        }, 4);
+    }
+
+    template <class Cost>
+    void dijkstra(const std::vector<RouteRequest>& reqs, std::vector<RouteResult>& out, Cost&& cost, bool withPath = true) {
+        run(reqs, out, [&](RouteWorker& w, const RouteRequest& q, RouteResult& r) {
+            r.cost = ::dijkstra(g, w.search, q.start, q.goal, cost);
+            if (withPath && r.cost < INF_DIST) w.search.path(q.goal, w.path);
+        }, withPath);
+    }
+
+    //    (state->weight) , ĳ epoch = state->version
+    //    state   Ƿ ߿  ŵ  θ Ž
+    void dijkstraLive(const std::vector<RouteRequest>& reqs, std::vector<RouteResult>& out,
+                      const std::shared_ptr<const TrafficState>& state, bool withPath = true) {
+        cacheEpoch = state->version;
+        const TrafficState& st = *state;
+        dijkstra(reqs, out, [&st](uint32_t, uint32_t e) { return st.weight[e]; }, withPath);
+    }
+
+    //  () 
+    void dijkstra(const std::vector<RouteRequest>& reqs, std::vector<RouteResult>& out, bool withPath = true) {
+        const Graph& gr = g;
+        dijkstra(reqs, out, [&gr](uint32_t, uint32_t e) { return gr.length[e]; }, withPath);
+    }
+
+private:
+    const Graph& g;
+    ThreadPool pool;
+    std::vector<RouteWorker> workers;
+    RouteCache* cache = nullptr;
+    uint64_t cacheEpoch = 0;
+};
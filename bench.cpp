@@ -0,0 +1,431 @@
+/*
+ bench.cpp :  Ž ġũ
+   : bench [--graph .graphml | --grid N] [--queries Q] [--seed S] [--threads 1,2,4] [--walks W] [--shards C] [--matrix RxC]
+   --graph   : GraphML (  mmap), ⺻ jongro.graphml
+   --grid N  : N x N ռ  (Ը Ȯ ,  Ϻθ seed  )
+   --queries :    (⺻ 1000, 1 ̻), Monte Carlo   1/50
+   --seed    :   seed ( seed    )
+   --threads : ó    
+   --walks   : Monte Carlo ȱ Ƚ (⺻ 2000,  1000)
+   --shards C :  ִ C     /ε   θ long Ƿ ü Dijkstra  
+   --matrix RxC :   R  x  C    (N*M dijkstra , one-to-many, costMatrix   / CH)
+   :    p50 / p99 / p999 (us),  Ȯ  , 32 Ʈ    ,   ó,
+         ߵ (α  50  90%) ĳ ߷ ó, ִ RSS
+   
+   - local :  ݰ 1.5km   (̿  ׷ ڶ ŭ  )
+   - long  : ׷ ü  
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "search.h"
+#include "snapshot.h"
+#include "spatial.h"
+#include "sampler.h"
+#include "batch.h"
+#include "cache.h"
+#include "compact.h"
+#include "live.h"
+#include "matrix.h"
+#include "partition.h"
+#include "shard.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+/* ================================
+     (Ǵ us, Ǵ Ȯ  )
+   ================================ */
+struct Samples {
+    vector<double> us;
+    uint64_t settled = 0;
+};
+
+static double percentile(vector<double>& v, double p) {
+    if (v.empty()) return 0;
+    size_t k = (size_t)min<double>((double)v.size() - 1, floor(p * (double)v.size()));
+    nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+static void report(const string& name, Samples& s) {
+    size_t n = s.us.size();
+    double sum = 0;
+    for (double x : s.us) sum += x;
+    printf("%-22s %7zu %10.1f %10.1f %10.1f %10.1f %12.0f\n", name.c_str(), n, n ? sum / n : 0.0,
+           percentile(s.us, 0.50), percentile(s.us, 0.99), percentile(s.us, 0.999), n ? (double)s.settled / n : 0.0);
+}
+
+static double peakRssMB() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return pmc.PeakWorkingSetSize / 1048576.0;
+    return 0;
+#else
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+    return ru.ru_maxrss / 1048576.0; // Ʈ
+#else
+    return ru.ru_maxrss / 1024.0;    // KB
+#endif
+#endif
+}
+
+/* =========================================================
+   ռ  :  α ǥ N x N , ǥ ݾ   5% 
+   ========================================================= */
+static Graph syntheticGrid(uint32_t side, uint64_t seed) {
+    mt19937_64 rng(seed);
+    auto jitter = [&]() { return ((double)(rng() % 2001) - 1000.0) * 1e-7; };
+    GraphBuilder b;
+    for (uint32_t r = 0; r < side; r++)
+        for (uint32_t c = 0; c < side; c++)
+            b.addNode("g" + to_string(r) + "_" + to_string(c), 37.55 + r * 0.0009 + jitter(), 126.95 + c * 0.00113 + jitter());
+    for (uint32_t r = 0; r < side; r++) {
+        for (uint32_t c = 0; c < side; c++) {
+            uint32_t u = r * side + c;
+            if (c + 1 < side && rng() % 100 >= 5) { b.addEdge(u, u + 1, NAN, ""); b.addEdge(u + 1, u, NAN, ""); }
+            if (r + 1 < side && rng() % 100 >= 5) { b.addEdge(u, u + side, NAN, ""); b.addEdge(u + side, u, NAN, ""); }
+        }
+    }
+    return b.build();
+}
+
+template <class Fn>
+static double timeUs(Fn&& fn) {
+    auto t0 = chrono::steady_clock::now();
+    fn();
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - t0).count();
+}
+
+/* =========================================================
+     :     //ٽ б   θ ü Dijkstra  
+   ========================================================= */
+static void benchShards(const Graph& g, const vector<RouteRequest>& qs, uint32_t cellSize) {
+    PartitionOptions opt;
+    opt.maxCellSize = cellSize;
+    Partition p;
+    double partMs = timeUs([&]() { p = inertialFlow(g, opt); }) / 1000;
+
+    Span<double> w(g.length);
+    vector<ShardRouter> shards(p.numCells);
+    vector<string> files;
+    size_t maxBytes = 0, totalBytes = 0;
+    bool reloaded = true;
+    double buildMs = timeUs([&]() {
+        for (uint32_t c = 0; c < p.numCells; c++) {
+            //  μó  Ͽ ٽ  ͸ 
+            string f = "bench_shard_" + to_string(c) + ".bin";
+            files.push_back(f);
+            reloaded = ShardRouter(g, p, c, w).save(f) && shards[c].load(f) && reloaded;
+            maxBytes = max(maxBytes, shards[c].memoryBytes());
+            totalBytes += shards[c].memoryBytes();
+        }
+    }) / 1000;
+    vector<ShardRouter*> ptr;
+    for (auto& sh : shards) ptr.push_back(&sh);
+    Coordinator coord(ptr, cutEdges(g, p, w));
+
+    SearchWorkspace ws(g.numNodes());
+    vector<uint32_t> path;
+    Samples global, sharded;
+    size_t mismatch = 0;
+    for (auto& q : qs) {
+        double ref = 0, d = 0;
+        global.us.push_back(timeUs([&]() { ref = dijkstra(g, ws, q.start, q.goal); }));
+        sharded.us.push_back(timeUs([&]() { d = coord.route(q.start, q.goal, &path); }));
+        bool same = ref >= INF_DIST ? d >= INF_DIST : fabs(d - ref) <= 1e-6 * max(1.0, ref);
+        if (same && d < INF_DIST) {
+            // ΰ   ̾    
+            double len = 0;
+            same = path.front() == q.start && path.back() == q.goal;
+            for (size_t k = 1; same && k < path.size(); k++) {
+                double best = INF_DIST;
+                for (uint32_t e = g.edgeBegin(path[k - 1]); e < g.edgeEnd(path[k - 1]); e++)
+                    if (g.target[e] == path[k]) best = min(best, g.length[e]);
+                same = best < INF_DIST;
+                len += best;
+            }
+            same = same && fabs(len - ref) <= 1e-6 * max(1.0, ref);
+        }
+        mismatch += !same;
+    }
+    for (auto& f : files) {
+        remove(f.c_str());
+        remove((f + ".meta").c_str());
+    }
+
+    printf("\nshards : cell <= %u nodes, %u cells, boundary %u nodes, cut %zu edges, partition %.1f ms, build/save/load %.1f ms%s\n",
+           cellSize, p.numCells, p.numBoundary(), p.cutEdges.size(), partMs, buildMs, reloaded ? "" : " (load FAILED)");
+    printf("%-22s overlay %u nodes / %u edges, shard max %.1f KB, total %.1f KB\n", "", coord.overlayNodes(),
+           coord.overlayEdges(), maxBytes / 1024.0, totalBytes / 1024.0);
+    report("dijkstra (global)", global);
+    report("coordinator", sharded);
+    printf("%-22s %zu / %zu mismatches against global Dijkstra\n", "", mismatch, qs.size());
+}
+
+/* =========================================================
+     : rows x cols  N*M  dijkstra() ذ 
+   - costMatrix    (8  ) / CH    (bucket)  
+   ========================================================= */
+static void benchMatrix(const Graph& g, uint32_t rows, uint32_t cols, uint64_t seed, unsigned threads) {
+    mt19937_64 rng(seed + 13);
+    vector<uint32_t> sources(rows), targets(cols);
+    for (auto& s : sources) s = (uint32_t)(rng() % g.numNodes());
+    for (auto& t : targets) t = (uint32_t)(rng() % g.numNodes());
+    Span<double> w(g.length);
+
+    CostMatrix base;
+    base.rows = rows;
+    base.cols = cols;
+    base.data.assign((size_t)rows * cols, INFINITY);
+    SearchWorkspace ws(g.numNodes());
+    double baseMs = timeUs([&]() {
+        for (uint32_t i = 0; i < rows; i++)
+            for (uint32_t j = 0; j < cols; j++) {
+                double d = dijkstra(g, ws, sources[i], targets[j]);
+                if (d < INF_DIST) base.data[(size_t)i * cols + j] = (float)d;
+            }
+    }) / 1000;
+
+    // ذ ִ   (float е),   ΰ ٸ Ѵ
+    auto maxDiff = [&](const CostMatrix& m) {
+        double worst = 0;
+        for (size_t k = 0; k < base.data.size(); k++) {
+            float a = base.data[k], b = m.data[k];
+            if (isinf(a) || isinf(b)) worst = isinf(a) == isinf(b) ? worst : INFINITY;
+            else worst = max(worst, fabs((double)a - b) / max(1.0, (double)a));
+        }
+        return worst;
+    };
+
+    CostMatrix m;
+    m.rows = rows;
+    m.cols = cols;
+    m.data.assign((size_t)rows * cols, INFINITY);
+    double oneMs = timeUs([&]() {
+        for (uint32_t i = 0; i < rows; i++) oneToMany(g, ws, w, sources[i], targets, &m.data[(size_t)i * cols]);
+    }) / 1000;
+    double oneDiff = maxDiff(m);
+    double laneMs = timeUs([&]() { costMatrix(g, w, nullptr, sources, targets, m, threads); }) / 1000;
+    double laneDiff = maxDiff(m);
+    CHGraph ch;
+    double chBuildMs = timeUs([&]() { ch = buildCH(g, w); }) / 1000;
+    double chMs = timeUs([&]() { costMatrix(g, w, &ch, sources, targets, m, threads); }) / 1000;
+    double chDiff = maxDiff(m);
+
+    printf("\n%-22s %12s %12s\n", ("matrix " + to_string(rows) + "x" + to_string(cols)).c_str(), "time(ms)",
+           "max rel diff");
+    printf("%-22s %12.1f %12s\n", "N*M dijkstra", baseMs, "-");
+    printf("%-22s %12.1f %12.2e\n", "one-to-many", oneMs, oneDiff);
+    printf("%-22s %12.1f %12.2e\n", "costMatrix (lanes)", laneMs, laneDiff);
+    printf("%-22s %12.1f %12.2e   (CH build %.1f ms)\n", "costMatrix (CH)", chMs, chDiff, chBuildMs);
+}
+
+int main(int argc, char** argv) {
+    string file = "jongro.graphml";
+    uint32_t grid = 0, queries = 1000, walks = 2000, shardCell = 0, matrixRows = 0, matrixCols = 0;
+    uint64_t seed = 1;
+    vector<unsigned> threadCounts = { 1, 2, 4 };
+    for (int i = 1; i < argc; i++) {
+        string a = argv[i];
+        auto next = [&]() { return i + 1 < argc ? string(argv[++i]) : string(); };
+        if (a == "--graph") file = next();
+        else if (a == "--grid") grid = (uint32_t)stoul(next());
+        else if (a == "--queries") queries = (uint32_t)stoul(next());
+        else if (a == "--seed") seed = stoull(next());
+        else if (a == "--walks") walks = (uint32_t)stoul(next());
+        else if (a == "--shards") shardCell = (uint32_t)stoul(next());
+        else if (a == "--matrix") {
+            string v = next();
+            size_t x = v.find('x');
+            matrixRows = (uint32_t)stoul(v.substr(0, x));
+            matrixCols = x == string::npos ? matrixRows : (uint32_t)stoul(v.substr(x + 1));
+        }
+        else if (a == "--threads") {
+            threadCounts.clear();
+            stringstream ss(next());
+            for (string t; getline(ss, t, ',');) if (!t.empty()) threadCounts.push_back((unsigned)stoul(t));
+        } else {
+            cerr << " : bench [--graph ] [--grid N] [--queries Q] [--seed S] [--threads 1,2,4] [--walks W] [--shards ũ] [--matrix RxC]\n";
+            return 1;
+        }
+    }
+    if (queries == 0) {
+        cerr << "--queries  1 ̻\n";
+        return 1;
+    }
+
+    // 1) ׷ (  ε)
+    Graph g;
+    double loadMs = timeUs([&]() {
+        if (grid) g = syntheticGrid(grid, seed);
+        else if (!loadGraph(file, g)) g = Graph();
+    }) / 1000;
+    if (g.numNodes() == 0) {
+        cerr << "Graph load failed : " << file << "\n";
+        return 1;
+    }
+    SpatialIndex spatial;
+    double indexMs = timeUs([&]() { spatial.build(g); }) / 1000;
+    printf("graph : %s, nodes %u, edges %u, load %.1f ms, spatial index %.1f ms\n",
+           grid ? ("grid " + to_string(grid) + "x" + to_string(grid)).c_str() : file.c_str(),
+           g.numNodes(), g.numEdges(), loadMs, indexMs);
+
+    // 2)   (seed  )
+    mt19937_64 rng(seed);
+    uint32_t n = g.numNodes();
+    vector<RouteRequest> local, longq;
+    vector<Neighbor> near;
+    // ݰ ȿ ̿  ׷(--grid 1 )  õ Ƚ   ڶ  
+    for (uint64_t tries = 0; local.size() < queries && tries < (uint64_t)queries * 20; tries++) {
+        uint32_t s = (uint32_t)(rng() % n);
+        spatial.withinRadius(g.lat[s], g.lon[s], 1500, near);
+        if (near.size() < 2) continue;
+        uint32_t t = near[1 + rng() % (near.size() - 1)].node;
+        local.push_back({ s, t });
+    }
+    while (local.size() < queries) local.push_back({ (uint32_t)(rng() % n), (uint32_t)(rng() % n) });
+    for (uint32_t i = 0; i < queries; i++) longq.push_back({ (uint32_t)(rng() % n), (uint32_t)(rng() % n) });
+
+    double minLat = *min_element(g.lat.begin(), g.lat.end()), maxLat = *max_element(g.lat.begin(), g.lat.end());
+    double minLon = *min_element(g.lon.begin(), g.lon.end()), maxLon = *max_element(g.lon.begin(), g.lon.end());
+    vector<pair<double, double>> points;
+    for (uint32_t i = 0; i < queries; i++) {
+        double fy = (double)(rng() % 1000001) / 1e6, fx = (double)(rng() % 1000001) / 1e6;
+        points.push_back({ minLat + (maxLat - minLat) * fy, minLon + (maxLon - minLon) * fx });
+    }
+
+    // 3)   
+    printf("\n%-22s %7s %10s %10s %10s %10s %12s\n", "query", "count", "mean(us)", "p50(us)", "p99(us)", "p999(us)",
+           "settled");
+    InstrumentedWorkspace ws(n);
+    InstrumentedBidirectionalWorkspace bw;
+    bw.fwd.resize(n);
+    bw.bwd.resize(n);
+    auto length = [&g](uint32_t, uint32_t e) { return g.length[e]; };
+    CompactGraph<FixedWeight<100>> fixedG(g);
+    CompactGraph<FloatWeight> floatG(g);
+    CompactWorkspace<FixedWeight<100>> fixedWs(n);
+    CompactWorkspace<FloatWeight> floatWs(n);
+
+    for (int set = 0; set < 2; set++) {
+        auto& qs = set == 0 ? local : longq;
+        string tag = set == 0 ? " (local)" : " (long)";
+        Samples dj, as, bd;
+        for (auto& q : qs) {
+            ws.stats.clear();
+            dj.us.push_back(timeUs([&]() { dijkstra(g, ws, q.start, q.goal); }));
+            dj.settled += ws.stats.settled;
+
+            ws.stats.clear();
+            as.us.push_back(timeUs([&]() { astar(g, ws, q.start, q.goal, length, StraightLineHeuristic(g, q.goal)); }));
+            as.settled += ws.stats.settled;
+
+            bw.fwd.stats.clear();
+            bw.bwd.stats.clear();
+            bd.us.push_back(timeUs([&]() { bidirectionalDijkstra(g, bw, q.start, q.goal); }));
+            bd.settled += bw.fwd.stats.settled + bw.bwd.stats.settled;
+        }
+        report("dijkstra" + tag, dj);
+        report("astar" + tag, as);
+        report("bidirectional" + tag, bd);
+
+        // 32 Ʈ  Dijkstra (   settled 0),  Dijkstra  ִ  ̸  
+        Samples fx, fl;
+        double fxErr = 0, flErr = 0;
+        for (auto& q : qs) {
+            double ref = dijkstra(g, ws, q.start, q.goal), d = 0;
+            fx.us.push_back(timeUs([&]() { d = compactDijkstra(fixedG, fixedWs, q.start, q.goal); }));
+            if (ref < INF_DIST) fxErr = max(fxErr, fabs(d - ref));
+            fl.us.push_back(timeUs([&]() { d = compactDijkstra(floatG, floatWs, q.start, q.goal); }));
+            if (ref < INF_DIST) flErr = max(flErr, fabs(d - ref));
+        }
+        report("fixed32" + tag, fx);
+        report("float32" + tag, fl);
+        printf("%-22s max error fixed %.2f m, float %.2f m\n", "", fxErr, flErr);
+
+        // Monte Carlo  Ǵ ȱ õ   Ϻθ (settled ڸ    )
+        Samples mc;
+        WalkOptions opt;
+        opt.walks = walks;
+        opt.threads = 1;
+        for (size_t i = 0; i < min(qs.size(), max<size_t>(1, qs.size() / 50)); i++) {
+            opt.seed = seed + i;
+            WalkResult r;
+            mc.us.push_back(timeUs([&]() { r = randomWalkSample(g, qs[i].start, qs[i].goal, opt); }));
+            mc.settled += r.walkedSteps;
+        }
+        report("monteCarlo" + tag, mc);
+    }
+
+    Samples fn;
+    size_t matched = 0;
+    for (auto& p : points)
+        fn.us.push_back(timeUs([&]() { matched += spatial.nearest(p.first, p.second, 20.0) != INVALID_NODE; }));
+    report("findNode", fn);
+    printf("%-22s %zu / %zu points within 20 m\n", "", matched, points.size());
+
+    // 4)   ó (long ,   븸)
+    printf("\n%-10s %12s %12s\n", "threads", "queries/s", "time(ms)");
+    vector<RouteResult> out;
+    for (unsigned t : threadCounts) {
+        BatchRouter router(g, t);
+        double us = timeUs([&]() { router.dijkstra(longq, out, false); });
+        printf("%-10u %12.0f %12.1f\n", router.threads(), longq.size() / (us / 1e6), us / 1000);
+    }
+
+    // 5)  ĳ : α (, ) ֿ   (ĳ  / )
+    //     LiveTraffic        (),      (version  ٲ ȿȭ)
+    vector<RouteRequest> skewed;
+    size_t hot = min<size_t>(50, longq.size());
+    for (uint32_t i = 0; i < queries * 4; i++)
+        skewed.push_back(rng() % 10 < 9 ? longq[rng() % hot] : longq[rng() % longq.size()]);
+    printf("\n%-22s %12s %12s %10s\n", "skewed", "queries/s", "time(ms)", "hit rate");
+    {
+        LiveTraffic live(g, vector<double>(g.length.begin(), g.length.end()));
+        BatchRouter router(g, threadCounts.empty() ? 1 : threadCounts.back());
+        double us = timeUs([&]() { router.dijkstraLive(skewed, out, live.current()); });
+        printf("%-22s %12.0f %12.1f %10s\n", "no cache", skewed.size() / (us / 1e6), us / 1000, "-");
+
+        RouteCache cache(16u << 20);
+        router.useCache(&cache);
+        for (int round = 0; round < 3; round++) {
+            if (round == 2) live.apply({ { 0, g.numEdges() ? g.target[0] : 0, 30.0 } });
+            auto state = live.current();
+            CacheCounters before = cache.counters();
+            us = timeUs([&]() { router.dijkstraLive(skewed, out, state); });
+            CacheCounters c = cache.counters();
+            double rate = (double)(c.hits - before.hits) / (double)skewed.size();
+            string name = "cache v" + to_string(state->version) + (round == 1 ? " (again)" : "");
+            printf("%-22s %12.0f %12.1f %9.1f%%\n", name.c_str(), skewed.size() / (us / 1e6), us / 1000, rate * 100);
+        }
+        CacheCounters c = cache.counters();
+        printf("%-22s entries %llu, %.1f KB, stale %llu, evictions %llu\n", "", (unsigned long long)c.entries,
+               c.bytes / 1024.0, (unsigned long long)c.stale, (unsigned long long)c.evictions);
+    }
+
+    // 6)  /  (--shards   츸)
+    if (shardCell) benchShards(g, longq, shardCell);
+
+    // 7)   (--matrix   츸)
+    if (matrixRows && matrixCols) benchMatrix(g, matrixRows, matrixCols, seed, threadCounts.empty() ? 1 : threadCounts.back());
+
+    printf("\npeak RSS : %.1f MB\n", peakRssMB());
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "cache.h"
+
+#include <algorithm>
+
+using namespace std;
+
+/* =========================================================
+   RouteCache
+   - shard  2  ŵ ø, Ű ؽ  Ʈ shard 
+   - ׸ ũ : Entry +   + ؽ /  뷫ġ
+   ========================================================= */
+RouteCache::RouteCache(size_t maxBytes, unsigned shards) {
+    unsigned n = 1;
+    while (n < max(1u, shards)) n *= 2;
+    mask_ = n - 1;
+    limit_ = max<size_t>(maxBytes / n, 1);
+    for (unsigned i = 0; i < n; i++) shards_.push_back(make_unique<Shard>());
+}
+
+size_t RouteCache::bytesOf(const Entry& e) {
+    return sizeof(Entry) + e.path.capacity() * sizeof(uint32_t) + 4 * sizeof(void*) + sizeof(uint64_t);
+}
+
+void RouteCache::erase(Shard& sh, list<Entry>::iterator it) {
+    sh.bytes -= bytesOf(*it);
+    sh.index.erase(it->key);
+    sh.lru.erase(it);
+}
+
+bool RouteCache::lookup(uint32_t start, uint32_t goal, uint64_t epoch, double& cost, vector<uint32_t>* path) {
+    uint64_t key = keyOf(start, goal);
+    Shard& sh = shardOf(key);
+    lock_guard<mutex> guard(sh.lock);
+    auto it = sh.index.find(key);
+    if (it == sh.index.end()) {
+        sh.misses++;
+        return false;
+    }
+    if (it->second->epoch != epoch) {
+        //  epoch (Ǵ    epoch)  :  epoch  ٽ ؼ ֵ 
+        if (it->second->epoch < epoch) {
+            erase(sh, it->second);
+            sh.stale++;
+        }
+        sh.misses++;
+        return false;
+    }
+    if (path && !it->second->hasPath) {
+        sh.misses++;
+        return false;
+    }
+    sh.lru.splice(sh.lru.begin(), sh.lru, it->second);
+    sh.hits++;
+    cost = it->second->cost;
+    if (path) path->assign(it->second->path.begin(), it->second->path.end());
+    return true;
+}
+
+void RouteCache::insert(uint32_t start, uint32_t goal, uint64_t epoch, double cost, const vector<uint32_t>& path,
+                        bool hasPath) {
+    uint64_t key = keyOf(start, goal);
+    Shard& sh = shardOf(key);
+    lock_guard<mutex> guard(sh.lock);
+    auto it = sh.index.find(key);
+    if (it != sh.index.end()) {
+        if (it->second->epoch > epoch || (it->second->epoch == epoch && it->second->hasPath && !hasPath)) return;
+        erase(sh, it->second);
+    }
+    sh.lru.push_front(Entry{ key, epoch, cost, hasPath ? vector<uint32_t>(path.begin(), path.end()) : vector<uint32_t>(),
+                             hasPath });
+    sh.index.emplace(key, sh.lru.begin());
+    sh.bytes += bytesOf(sh.lru.front());
+    sh.inserts++;
+
+    // ѵ ʰ :     ׸ (  ׸ )
+    while (sh.bytes > limit_ && sh.lru.size() > 1) {
+        erase(sh, prev(sh.lru.end()));
+        sh.evictions++;
+    }
+}
+
+void RouteCache::clear() {
+    for (auto& p : shards_) {
+        lock_guard<mutex> guard(p->lock);
+        p->lru.clear();
+        p->index.clear();
+        p->bytes = 0;
+    }
+}
+
+CacheCounters RouteCache::counters() const {
+    CacheCounters c;
+    for (auto& p : shards_) {
+        lock_guard<mutex> guard(p->lock);
+        c.hits += p->hits;
+        c.misses += p->misses;
+        c.stale += p->stale;
+        c.inserts += p->inserts;
+        c.evictions += p->evictions;
+        c.entries += p->lru.size();
+        c.bytes += p->bytes;
+    }
+    return c;
+}
+
+void exportCounters(ostream& out, const CacheCounters& c, const string& prefix, const string& labels) {
+    string l = labels.empty() ? "" : "{" + labels + "}";
+    out << prefix << "_cache_hits_total" << l << " " << c.hits << "\n"
+        << prefix << "_cache_misses_total" << l << " " << c.misses << "\n"
+        << prefix << "_cache_stale_total" << l << " " << c.stale << "\n"
+        << prefix << "_cache_inserts_total" << l << " " << c.inserts << "\n"
+        << prefix << "_cache_evictions_total" << l << " " << c.evictions << "\n"
+        << prefix << "_cache_entries" << l << " " << c.entries << "\n"
+        << prefix << "_cache_bytes" << l << " " << c.bytes << "\n";
+}
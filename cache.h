@@ -0,0 +1,80 @@
+/*
+ cache.h : ݺǴ (, )   ĳ
+  - Ű : (  ,  ), ׸񸶴 epoch   
+  - epoch  ö󰡸  epoch ׸ ã      ü   ȿȭ
+    BatchRouter::dijkstraLive(reqs, out, state)  TrafficState::version  epoch  
+  - shard  mutex + LRU , ü ޸𸮴 maxBytes  (   ؼ )
+  - ĳ ϳ  Լ ϳ  ( epoch  ٸ     )
+  - ) RouteCache cache(32 << 20);
+        router.useCache(&cache);
+        router.dijkstraLive(reqs, out, traffic.current());
+*/
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct CacheCounters {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t stale = 0;      // epoch    ׸
+    uint64_t inserts = 0;
+    uint64_t evictions = 0;  // ޸ ѵ  з ׸
+    uint64_t entries = 0;
+    uint64_t bytes = 0;
+
+    double hitRate() const { return hits + misses ? (double)hits / (double)(hits + misses) : 0.0; }
+};
+
+class RouteCache {
+public:
+    explicit RouteCache(size_t maxBytes = 64u << 20, unsigned shards = 16);
+
+    //  cost ( path)  ä true, epoch  ٸ ׸  false
+    // path  ޶ ߴµ 븸  ׸̸ false (θ  ٽ insert)
+    bool lookup(uint32_t start, uint32_t goal, uint64_t epoch, double& cost, std::vector<uint32_t>* path = nullptr);
+
+    //  Ű   epoch ׸ ̹  
+    // hasPath = false : 븸 (θ û  ),  epoch   ִ ׸  
+    void insert(uint32_t start, uint32_t goal, uint64_t epoch, double cost, const std::vector<uint32_t>& path,
+                bool hasPath = true);
+
+    void clear();
+    CacheCounters counters() const;
+    size_t maxBytes() const { return limit_ * shards_.size(); }
+
+private:
+    struct Entry {
+        uint64_t key;
+        uint64_t epoch;
+        double cost;
+        std::vector<uint32_t> path;
+        bool hasPath;
+    };
+    struct Shard {
+        mutable std::mutex lock;
+        std::list<Entry> lru; //  ֱ 
+        std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+        size_t bytes = 0;
+        uint64_t hits = 0, misses = 0, stale = 0, inserts = 0, evictions = 0;
+    };
+
+    static uint64_t keyOf(uint32_t s, uint32_t g) { return ((uint64_t)s << 32) | g; }
+    static size_t bytesOf(const Entry& e);
+    Shard& shardOf(uint64_t key) { return *shards_[((key * 0x9E3779B97F4A7C15ull) >> 32) & mask_]; }
+    void erase(Shard& sh, std::list<Entry>::iterator it);
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    uint32_t mask_;
+    size_t limit_; // shard  Ʈ ѵ
+};
+
+// ī  : prefix_cache_hits_total{labels} 123  (stats.h  exportCounters   )
+void exportCounters(std::ostream& out, const CacheCounters& c, const std::string& prefix,
+                    const std::string& labels = "");
@@ -0,0 +1,362 @@
+#include "cch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <unordered_set>
+
+#include "parallel.h"
+
+using namespace std;
+
+/* =========================================================
+   Nested dissection 
+   - /浵    ߾Ӱ ̺
+   -   (ݴ  )    separator  
+   -  = () + () + separator
+   ========================================================= */
+namespace {
+
+struct Dissector {
+    const Graph& g;
+    vector<uint32_t> side;
+    uint32_t stamp = 0;
+    vector<uint32_t>& out;
+
+    Dissector(const Graph& g, vector<uint32_t>& out) : g(g), side(g.numNodes(), 0), out(out) {}
+
+    template <class Fn>
+    void forNeighbours(uint32_t u, Fn&& fn) const {
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) fn(g.target[e]);
+        for (uint32_t k = g.inBegin(u); k < g.inEnd(u); k++) fn(g.rSource[k]);
+    }
+
+    void boundary(const vector<uint32_t>& part, uint32_t other, vector<uint32_t>& res) const {
+        for (uint32_t u : part) {
+            bool b = false;
+            forNeighbours(u, [&](uint32_t v) { if (side[v] == other) b = true; });
+            if (b) res.push_back(u);
+        }
+    }
+
+    void run(vector<uint32_t>& nodes) {
+        if (nodes.size() <= 16) {
+            out.insert(out.end(), nodes.begin(), nodes.end());
+            return;
+        }
+
+        // 1)    (浵 cos(lat) )
+        double minLat = 1e9, maxLat = -1e9, minLon = 1e9, maxLon = -1e9;
+        for (uint32_t u : nodes) {
+            minLat = min(minLat, g.lat[u]); maxLat = max(maxLat, g.lat[u]);
+            minLon = min(minLon, g.lon[u]); maxLon = max(maxLon, g.lon[u]);
+        }
+        double kx = cos((minLat + maxLat) * 0.5 * 3.14159265358979323846 / 180.0);
+        bool byLat = (maxLat - minLat) >= (maxLon - minLon) * kx;
+
+        size_t half = nodes.size() / 2;
+        nth_element(nodes.begin(), nodes.begin() + half, nodes.end(), [&](uint32_t a, uint32_t b) {
+            return byLat ? g.lat[a] < g.lat[b] : g.lon[a] < g.lon[b];
+        });
+        vector<uint32_t> A(nodes.begin(), nodes.begin() + half);
+        vector<uint32_t> B(nodes.begin() + half, nodes.end());
+        nodes.clear();
+        nodes.shrink_to_fit();
+
+        // 2) separator :  尡  
+        uint32_t sa = ++stamp, sb = ++stamp;
+        for (uint32_t u : A) side[u] = sa;
+        for (uint32_t u : B) side[u] = sb;
+        vector<uint32_t> ba, bb;
+        boundary(A, sb, ba);
+        boundary(B, sa, bb);
+
+        vector<uint32_t> sep;
+        vector<uint32_t>& from = (ba.size() <= bb.size()) ? A : B;
+        sep = (ba.size() <= bb.size()) ? move(ba) : move(bb);
+        uint32_t cut = ++stamp;
+        for (uint32_t u : sep) side[u] = cut;
+        from.erase(remove_if(from.begin(), from.end(), [&](uint32_t u) { return side[u] == cut; }), from.end());
+
+        // 3) 
+        run(A);
+        run(B);
+        out.insert(out.end(), sep.begin(), sep.end());
+    }
+};
+
+} // namespace
+
+vector<uint32_t> nestedDissectionOrder(const Graph& g) {
+    vector<uint32_t> order;
+    order.reserve(g.numNodes());
+    vector<uint32_t> all(g.numNodes());
+    for (uint32_t u = 0; u < g.numNodes(); u++) all[u] = u;
+    Dissector(g, order).run(all);
+    return order;
+}
+
+uint32_t CCH::findArc(uint32_t u, uint32_t v) const {
+    auto b = head.begin() + upOffset[u], e = head.begin() + upOffset[u + 1];
+    auto it = lower_bound(b, e, v);
+    return (it != e && *it == v) ? (uint32_t)(it - head.begin()) : INVALID_EDGE;
+}
+
+/* =========================================================
+   CCH ó ( )
+   1)   rank
+   2) elimination game :    ̿ clique   (witness Ž )
+   3)  ﰢ ,    arc , level 
+   ========================================================= */
+CCH buildCCH(const Graph& g) {
+    CCH c;
+    uint32_t n = g.numNodes();
+    c.order = nestedDissectionOrder(g);
+    c.rank.assign(n, 0);
+    for (uint32_t r = 0; r < n; r++) c.rank[c.order[r]] = r;
+
+    // 1)  ̿ (rank , )
+    vector<vector<uint32_t>> up(n);
+    for (uint32_t u = 0; u < n; u++) {
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+            uint32_t a = c.rank[u], b = c.rank[g.target[e]];
+            if (a == b) continue;
+            up[min(a, b)].push_back(max(a, b));
+        }
+    }
+
+    // 2) chordal  :    ̿(θ)  ̿ ѱ
+    c.parent.assign(n, INVALID_NODE);
+    for (uint32_t r = 0; r < n; r++) {
+        auto& U = up[r];
+        sort(U.begin(), U.end());
+        U.erase(unique(U.begin(), U.end()), U.end());
+        if (U.empty()) continue;
+        uint32_t p = U[0];
+        c.parent[r] = p;
+        up[p].insert(up[p].end(), U.begin() + 1, U.end());
+    }
+
+    c.upOffset.assign(n + 1, 0);
+    for (uint32_t r = 0; r < n; r++) c.upOffset[r + 1] = c.upOffset[r] + (uint32_t)up[r].size();
+    c.head.reserve(c.upOffset[n]);
+    c.tail.reserve(c.upOffset[n]);
+    for (uint32_t r = 0; r < n; r++) {
+        c.head.insert(c.head.end(), up[r].begin(), up[r].end());
+        c.tail.insert(c.tail.end(), up[r].size(), r);
+        vector<uint32_t>().swap(up[r]);
+    }
+    uint32_t arcs = c.numArcs();
+
+    // 3)  ﰢ : w   ̿  (u < v)  arc (u,v)
+    c.triOffset.assign(arcs + 1, 0);
+    for (uint32_t w = 0; w < n; w++) {
+        for (uint32_t i = c.upOffset[w]; i < c.upOffset[w + 1]; i++)
+            for (uint32_t j = i + 1; j < c.upOffset[w + 1]; j++)
+                c.triOffset[c.findArc(c.head[i], c.head[j]) + 1]++;
+    }
+    for (uint32_t a = 0; a < arcs; a++) c.triOffset[a + 1] += c.triOffset[a];
+    c.triLow.resize(c.triOffset[arcs]);
+    c.triHigh.resize(c.triOffset[arcs]);
+    vector<uint32_t> pos(c.triOffset.begin(), c.triOffset.end() - 1);
+    for (uint32_t w = 0; w < n; w++) {
+        for (uint32_t i = c.upOffset[w]; i < c.upOffset[w + 1]; i++) {
+            for (uint32_t j = i + 1; j < c.upOffset[w + 1]; j++) {
+                uint32_t k = pos[c.findArc(c.head[i], c.head[j])]++;
+                c.triLow[k] = i;   // arc (w, u)
+                c.triHigh[k] = j;  // arc (w, v)
+            }
+        }
+    }
+
+    // 4)    arc
+    c.edgeArc.assign(g.numEdges(), INVALID_EDGE);
+    c.edgeUp.assign(g.numEdges(), 0);
+    for (uint32_t u = 0; u < n; u++) {
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+            uint32_t a = c.rank[u], b = c.rank[g.target[e]];
+            if (a == b) continue;
+            c.edgeArc[e] = c.findArc(min(a, b), max(a, b));
+            c.edgeUp[e] = a < b;
+        }
+    }
+
+    // 5) level : Ʒ ̿ 1    level  arc    
+    vector<uint32_t> level(n, 0);
+    uint32_t maxLevel = 0;
+    for (uint32_t r = 0; r < n; r++) {
+        maxLevel = max(maxLevel, level[r]);
+        for (uint32_t a = c.upOffset[r]; a < c.upOffset[r + 1]; a++)
+            level[c.head[a]] = max(level[c.head[a]], level[r] + 1);
+    }
+    c.levelOffset.assign(maxLevel + 2, 0);
+    for (uint32_t r = 0; r < n; r++) c.levelOffset[level[r] + 1]++;
+    for (uint32_t l = 0; l <= maxLevel; l++) c.levelOffset[l + 1] += c.levelOffset[l];
+    c.levelNodes.resize(n);
+    vector<uint32_t> lp(c.levelOffset.begin(), c.levelOffset.end() - 1);
+    for (uint32_t r = 0; r < n; r++) c.levelNodes[lp[level[r]]++] = r;
+    return c;
+}
+
+/* =========================================================
+   Customization
+   1)    arc  ݿ (  ּҰ)
+   2)  level   ﰢ ȭ
+      up(u,v)   = min(up(u,v),   down(w,u) + up(w,v))    u  w  v
+      down(u,v) = min(down(u,v), down(w,v) + up(w,u))    v  w  u
+   ========================================================= */
+void customize(const CCH& c, Span<double> weight, CCHMetric& m, unsigned threads) {
+    uint32_t arcs = c.numArcs();
+    m.up.assign(arcs, INF_DIST);
+    m.down.assign(arcs, INF_DIST);
+    m.upMid.assign(arcs, INVALID_NODE);
+    m.downMid.assign(arcs, INVALID_NODE);
+
+    for (uint32_t e = 0; e < (uint32_t)c.edgeArc.size(); e++) {
+        uint32_t a = c.edgeArc[e];
+        if (a == INVALID_EDGE) continue;
+        double& w = c.edgeUp[e] ? m.up[a] : m.down[a];
+        w = min(w, weight[e]);
+    }
+
+    for (size_t l = 0; l + 1 < c.levelOffset.size(); l++) {
+        uint32_t b = c.levelOffset[l], e = c.levelOffset[l + 1];
+        parallelFor(e - b, threads, [&](unsigned, size_t i) {
+            uint32_t u = c.levelNodes[b + i];
+            for (uint32_t a = c.upOffset[u]; a < c.upOffset[u + 1]; a++) {
+                double up = m.up[a], down = m.down[a];
+                uint32_t upMid = m.upMid[a], downMid = m.downMid[a];
+                for (uint32_t k = c.triOffset[a]; k < c.triOffset[a + 1]; k++) {
+                    uint32_t lo = c.triLow[k], hi = c.triHigh[k];
+                    double viaUp = m.down[lo] + m.up[hi];
+                    double viaDown = m.down[hi] + m.up[lo];
+                    if (viaUp < up) { up = viaUp; upMid = c.tail[lo]; }
+                    if (viaDown < down) { down = viaDown; downMid = c.tail[lo]; }
+                }
+                m.up[a] = up; m.down[a] = down;
+                m.upMid[a] = upMid; m.downMid[a] = downMid;
+            }
+        }, 256);
+    }
+}
+
+/* =========================================================
+   κ customization :  ٲ   arc  ٽ 
+   - arc ȣ tail rank  CSR   ȣ óϸ  ﰢ ׻  Ȯ
+   - arc (w,x)  ٲ w  ٸ  ̿ y   arc (x,y)   
+   -  ״ arc   ߴ
+   ========================================================= */
+size_t customizeEdges(const CCH& c, const Graph& g, Span<double> weight, const vector<uint32_t>& edges, CCHMetric& m) {
+    priority_queue<uint32_t, vector<uint32_t>, greater<uint32_t>> pq;
+    unordered_set<uint32_t> queued;
+    auto push = [&](uint32_t a) {
+        if (a != INVALID_EDGE && queued.insert(a).second) pq.push(a);
+    };
+    for (uint32_t e : edges) push(c.edgeArc[e]);
+
+    size_t updated = 0;
+    while (!pq.empty()) {
+        uint32_t a = pq.top();
+        pq.pop();
+        queued.erase(a);
+
+        uint32_t t = c.tail[a], h = c.head[a];
+        double up = INF_DIST, down = INF_DIST;
+        uint32_t upMid = INVALID_NODE, downMid = INVALID_NODE;
+        for (uint32_t x : { c.order[t], c.order[h] }) {
+            for (uint32_t e = g.edgeBegin(x); e < g.edgeEnd(x); e++) {
+                if (c.edgeArc[e] != a) continue;
+                double& w = c.edgeUp[e] ? up : down;
+                w = min(w, weight[e]);
+            }
+        }
+        for (uint32_t k = c.triOffset[a]; k < c.triOffset[a + 1]; k++) {
+            uint32_t lo = c.triLow[k], hi = c.triHigh[k];
+            double viaUp = m.down[lo] + m.up[hi];
+            double viaDown = m.down[hi] + m.up[lo];
+            if (viaUp < up) { up = viaUp; upMid = c.tail[lo]; }
+            if (viaDown < down) { down = viaDown; downMid = c.tail[lo]; }
+        }
+        if (up == m.up[a] && down == m.down[a]) continue;
+        m.up[a] = up; m.down[a] = down;
+        m.upMid[a] = upMid; m.downMid[a] = downMid;
+        updated++;
+
+        for (uint32_t b = c.upOffset[t]; b < c.upOffset[t + 1]; b++) {
+            uint32_t y = c.head[b];
+            if (y != h) push(c.findArc(min(h, y), max(h, y)));
+        }
+    }
+    return updated;
+}
+
+/* =========================================================
+   CCH  : s, t  elimination tree   Ʈ ö󰡸 ȭ
+   -  ̿  elimination tree     óϸ Ȯ
+   ========================================================= */
+double cchQuery(const CCH& c, const CCHMetric& m, BidirectionalWorkspace& ws, uint32_t start, uint32_t goal) {
+    auto& F = ws.fwd;
+    auto& B = ws.bwd;
+    uint32_t n = c.numNodes();
+    if (F.size() != n) F.resize(n);
+    if (B.size() != n) B.resize(n);
+    F.reset();
+    B.reset();
+
+    auto sweep = [&](SearchWorkspace& W, uint32_t s, const vector<double>& w) {
+        W.set(s, 0, INVALID_NODE);
+        for (uint32_t x = s; x != INVALID_NODE; x = c.parent[x]) {
+            if (!W.reached(x)) continue;
+            double dx = W.dist(x);
+            for (uint32_t a = c.upOffset[x]; a < c.upOffset[x + 1]; a++) {
+                double nd = dx + w[a];
+                if (W.dist(c.head[a]) > nd) W.set(c.head[a], nd, x);
+            }
+        }
+    };
+    sweep(F, c.rank[start], m.up);
+    sweep(B, c.rank[goal], m.down);
+
+    double best = INF_DIST;
+    ws.meet = INVALID_NODE;
+    for (uint32_t x = c.rank[start]; x != INVALID_NODE; x = c.parent[x]) {
+        if (F.reached(x) && B.reached(x) && F.dist(x) + B.dist(x) < best) {
+            best = F.dist(x) + B.dist(x);
+            ws.meet = x;
+        }
+    }
+    return best;
+}
+
+/* =========================================================
+     : arc  ﰢ ߰   Ǯ
+   ========================================================= */
+static void unpackArc(const CCH& c, const CCHMetric& m, uint32_t a, bool upward, vector<uint32_t>& out) {
+    uint32_t u = c.tail[a], v = c.head[a];
+    uint32_t w = upward ? m.upMid[a] : m.downMid[a];
+    if (w == INVALID_NODE) {
+        out.push_back(c.order[upward ? v : u]);
+        return;
+    }
+    uint32_t wu = c.findArc(w, u), wv = c.findArc(w, v);
+    if (upward) {            // u  w  v
+        unpackArc(c, m, wu, false, out);
+        unpackArc(c, m, wv, true, out);
+    } else {                 // v  w  u
+        unpackArc(c, m, wv, false, out);
+        unpackArc(c, m, wu, true, out);
+    }
+}
+
+void cchPath(const CCH& c, const CCHMetric& m, const BidirectionalWorkspace& ws, vector<uint32_t>& out) {
+    out.clear();
+    if (ws.meet == INVALID_NODE) return;
+
+    vector<uint32_t> up;
+    ws.fwd.path(ws.meet, up);
+    out.push_back(c.order[up[0]]);
+    for (size_t i = 1; i < up.size(); i++) unpackArc(c, m, c.findArc(up[i - 1], up[i]), true, out);
+
+    for (uint32_t x = ws.meet, y = ws.bwd.prev(x); y != INVALID_NODE; x = y, y = ws.bwd.prev(y))
+        unpackArc(c, m, c.findArc(y, x), false, out);
+}
@@ -0,0 +1,75 @@
+/*
+ cch.h : Customizable Contraction Hierarchies (CCH)
+  - buildCCH()  :   ó (nested dissection  + chordal  ׷ + ﰢ )
+                  loadGraphML()   (topology) ,   
+  - customize() :  (Ÿ, ð + ȣ  ) ٲ  ٽ  (,   ̳)
+  - customizeEdges() : Ϻ  ٲ   ޴ arc  ٽ  (ǽð ſ)
+  - cchQuery()  : elimination tree  󰡴  upward Ž ( )
+  - cchPath()   : ﰢ ߰ 带    η 
+  迭  (rank)  :  ȣ  rank[u] 
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "graph.h"
+#include "search.h"
+
+/* ================================
+   CCH :   
+   - arc a : tail[a]  head[a] (rank      ), tail  CSR, head  
+   - ﰢ (triLow[k], triHigh[k]) : arc (w,u), (w,v)  arc (u,v)   ﰢ
+   ================================ */
+struct CCH {
+    std::vector<uint32_t> rank;      //   rank
+    std::vector<uint32_t> order;     // rank  
+    std::vector<uint32_t> parent;    // elimination tree θ (rank , Ʈ INVALID_NODE)
+
+    std::vector<uint32_t> upOffset;  // ũ n+1
+    std::vector<uint32_t> head;      // ũ arcs
+    std::vector<uint32_t> tail;      // ũ arcs
+
+    std::vector<uint32_t> triOffset; // arc   ﰢ [triOffset[a], triOffset[a+1])
+    std::vector<uint32_t> triLow, triHigh;
+
+    std::vector<uint32_t> edgeArc;   // Graph   arc
+    std::vector<uint8_t> edgeUp;     // 1 ̸ tail  head , 0 ̸ head  tail
+
+    std::vector<uint32_t> levelOffset; //  level   ķ customize 
+    std::vector<uint32_t> levelNodes;
+
+    uint32_t numNodes() const { return (uint32_t)rank.size(); }
+    uint32_t numArcs() const { return (uint32_t)head.size(); }
+
+    // rank u < rank v  arc (u,v) ȣ ( INVALID_EDGE)
+    uint32_t findArc(uint32_t u, uint32_t v) const;
+};
+
+/* ================================
+   CCHMetric : customize 
+   - up[a]   : tail  head ,  down[a] : head  tail 
+   - upMid / downMid : ﰢ ߰ (rank),  ̸ INVALID_NODE
+   ================================ */
+struct CCHMetric {
+    std::vector<double> up, down;
+    std::vector<uint32_t> upMid, downMid;
+};
+
+//   : ǥ   ̺, separator    
+std::vector<uint32_t> nestedDissectionOrder(const Graph& g);
+
+CCH buildCCH(const Graph& g);
+
+// weight[e] : Graph  e   
+void customize(const CCH& cch, Span<double> weight, CCHMetric& metric, unsigned threads = 0);
+
+// ̹ customize  metric  edges  븸 weight  ٲ    ٲ arc 
+size_t customizeEdges(const CCH& cch, const Graph& g, Span<double> weight, const std::vector<uint32_t>& edges,
+                      CCHMetric& metric);
+
+// start  goal  ( Ұ INF_DIST), ws.meet   (rank)
+double cchQuery(const CCH& cch, const CCHMetric& metric, BidirectionalWorkspace& ws, uint32_t start, uint32_t goal);
+
+//  cchQuery    η 
+void cchPath(const CCH& cch, const CCHMetric& metric, const BidirectionalWorkspace& ws, std::vector<uint32_t>& out);
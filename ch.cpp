@@ -0,0 +1,464 @@
+#include "ch.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "parallel.h"
+
+using namespace std;
+
+/* =========================================================
+   ó  ׷
+   - out[u] / in[v]     
+   ========================================================= */
+namespace {
+
+struct Arc {
+    uint32_t to;
+    double w;
+    uint32_t mid;
+};
+
+struct Shortcut {
+    uint32_t from, to;
+    double w;
+    uint32_t mid;
+};
+
+struct Contractor {
+    const CHOptions& opt;
+    uint32_t n;
+    vector<vector<Arc>> out, in;
+    vector<char> done, inSet;
+    vector<int> deleted;   // ̹  ̿ 
+    vector<int> prio;
+
+    Contractor(const Graph& g, Span<double> weight, const CHOptions& opt)
+        : opt(opt), n(g.numNodes()), out(n), in(n), done(n, 0), inSet(n, 0), deleted(n, 0), prio(n, 0) {
+        for (uint32_t u = 0; u < n; u++) {
+            for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+                uint32_t v = g.target[e];
+                if (v != u) addArc(u, v, weight[e], INVALID_NODE);
+            }
+        }
+    }
+
+    // u  v  ߰ (̹   ª  )
+    void addArc(uint32_t u, uint32_t v, double w, uint32_t mid) {
+        for (auto& a : out[u]) {
+            if (a.to != v) continue;
+            if (w < a.w) {
+                a.w = w;
+                a.mid = mid;
+                for (auto& b : in[v]) {
+                    if (b.to == u) { b.w = w; b.mid = mid; break; }
+                }
+            }
+            return;
+        }
+        out[u].push_back({ v, w, mid });
+        in[v].push_back({ u, w, mid });
+    }
+
+    bool blocked(uint32_t x) const { return done[x] || inSet[x]; }
+
+    bool isTarget(uint32_t v, uint32_t x) const {
+        for (auto& a : out[v]) if (a.to == x) return true;
+        return false;
+    }
+
+    /* -----------------------------------------
+       witness Ž : source  v  ġ ʰ limit ̳   ִ
+       - v   ̿(targets , source ڽ  )  settle Ǹ  
+       ----------------------------------------- */
+    void witness(SearchWorkspace& ws, uint32_t source, uint32_t v, double limit, uint32_t targets,
+                 uint32_t maxSettle) const {
+        ws.reset();
+        ws.set(source, 0, INVALID_NODE);
+        ws.queue.push(source, 0);
+        uint32_t settled = 0;
+
+        while (!ws.queue.empty()) {
+            auto [d, u] = ws.queue.pop();
+            if (d > limit || ++settled > maxSettle) break;
+            if (u != source && isTarget(v, u) && --targets == 0) break;
+            for (auto& a : out[u]) {
+                if (a.to == v || blocked(a.to)) continue;
+                double nd = d + a.w;
+                if (nd <= limit && ws.dist(a.to) > nd) {
+                    ws.set(a.to, nd, u);
+                    ws.queue.push(a.to, nd);
+                }
+            }
+        }
+    }
+
+    // v    ʿ shortcut 
+    void shortcuts(SearchWorkspace& ws, uint32_t v, vector<Shortcut>& res, uint32_t maxSettle) const {
+        res.clear();
+        for (auto& ia : in[v]) {
+            uint32_t u = ia.to;
+            if (blocked(u)) continue;
+
+            double limit = -1;
+            uint32_t targets = 0;
+            for (auto& oa : out[v]) {
+                if (oa.to == u || blocked(oa.to)) continue;
+                limit = max(limit, ia.w + oa.w);
+                targets++;
+            }
+            if (limit < 0) continue;
+
+            witness(ws, u, v, limit, targets, maxSettle);
+            for (auto& oa : out[v]) {
+                uint32_t x = oa.to;
+                if (x == u || blocked(x)) continue;
+                double w = ia.w + oa.w;
+                if (ws.dist(x) > w) res.push_back({ u, x, w, v });
+            }
+        }
+    }
+
+    // 켱 = edge difference +  ̿  (   witness Ž)
+    int priority(SearchWorkspace& ws, uint32_t v, vector<Shortcut>& tmp) const {
+        shortcuts(ws, v, tmp, opt.prioritySettle);
+        int removed = 0;
+        for (auto& a : in[v]) removed += !done[a.to];
+        for (auto& a : out[v]) removed += !done[a.to];
+        return (int)tmp.size() - removed + deleted[v];
+    }
+
+    template <class Fn>
+    void forNeighbours(uint32_t v, Fn&& fn) const {
+        for (auto& a : in[v]) if (!done[a.to]) fn(a.to);
+        for (auto& a : out[v]) if (!done[a.to]) fn(a.to);
+    }
+
+    //  带 Ű   (  Ʈ ª )
+    void compact(uint32_t w) {
+        auto dead = [this](const Arc& a) { return done[a.to] != 0; };
+        out[w].erase(remove_if(out[w].begin(), out[w].end(), dead), out[w].end());
+        in[w].erase(remove_if(in[w].begin(), in[w].end(), dead), in[w].end());
+    }
+};
+
+} // namespace
+
+uint32_t CHGraph::numShortcuts() const {
+    uint32_t c = 0;
+    for (uint32_t m : upMid) c += (m != INVALID_NODE);
+    for (uint32_t m : bwMid) c += (m != INVALID_NODE);
+    return c;
+}
+
+/* =========================================================
+   CH ó
+   -  帶 ̿ 켱  ( )   
+   -      ʰ witness ο    
+   ========================================================= */
+CHGraph buildCH(const Graph& g, Span<double> weight, const CHOptions& opt) {
+    Contractor c(g, weight, opt);
+    uint32_t n = c.n;
+    unsigned threads = opt.threads ? opt.threads : defaultThreads();
+
+    vector<SearchWorkspace> ws(threads);
+    for (auto& w : ws) w.resize(n);
+    vector<vector<Shortcut>> tmp(threads);
+
+    vector<uint32_t> alive(n);
+    for (uint32_t v = 0; v < n; v++) alive[v] = v;
+
+    parallelFor(n, threads, [&](unsigned tid, size_t v) {
+        c.prio[v] = c.priority(ws[tid], (uint32_t)v, tmp[tid]);
+    });
+
+    CHGraph ch;
+    ch.rank.assign(n, 0);
+    uint32_t nextRank = 0;
+
+    vector<uint32_t> set;
+    vector<vector<Shortcut>> found;
+    vector<uint32_t> touched;
+    vector<char> mark(n, 0);
+
+    while (!alive.empty()) {
+        // 1)    : (prio, id)   ִ ̿  
+        set.clear();
+        for (uint32_t v : alive) {
+            bool best = true;
+            c.forNeighbours(v, [&](uint32_t w) {
+                if (c.prio[w] < c.prio[v] || (c.prio[w] == c.prio[v] && w < v)) best = false;
+            });
+            if (best) set.push_back(v);
+        }
+        for (uint32_t v : set) c.inSet[v] = 1;
+
+        // 2) shortcut  ()
+        found.resize(set.size());
+        parallelFor(set.size(), threads, [&](unsigned tid, size_t i) {
+            c.shortcuts(ws[tid], set[i], found[i], opt.witnessSettle);
+        }, 4);
+
+        // 3)  ()
+        touched.clear();
+        for (size_t i = 0; i < set.size(); i++) {
+            uint32_t v = set[i];
+            for (auto& s : found[i]) c.addArc(s.from, s.to, s.w, s.mid);
+            ch.rank[v] = nextRank++;
+            c.forNeighbours(v, [&](uint32_t w) {
+                if (c.inSet[w]) return;
+                c.deleted[w]++;
+                if (!mark[w]) { mark[w] = 1; touched.push_back(w); }
+            });
+        }
+        for (uint32_t v : set) {
+            c.done[v] = 1;
+            c.inSet[v] = 0;
+        }
+        alive.erase(remove_if(alive.begin(), alive.end(), [&](uint32_t v) { return c.done[v] != 0; }), alive.end());
+
+        // 4)  ̿  + 켱  ()
+        for (uint32_t w : touched) { mark[w] = 0; c.compact(w); }
+        parallelFor(touched.size(), threads, [&](unsigned tid, size_t i) {
+            uint32_t w = touched[i];
+            c.prio[w] = c.priority(ws[tid], w, tmp[tid]);
+        }, 16);
+    }
+
+    // 5) CSR  ȯ :     
+    ch.upOffset.assign(n + 1, 0);
+    ch.bwOffset.assign(n + 1, 0);
+    for (uint32_t u = 0; u < n; u++) {
+        for (auto& a : c.out[u]) if (ch.rank[a.to] > ch.rank[u]) ch.upOffset[u + 1]++;
+        for (auto& a : c.in[u]) if (ch.rank[a.to] > ch.rank[u]) ch.bwOffset[u + 1]++;
+    }
+    for (uint32_t u = 0; u < n; u++) {
+        ch.upOffset[u + 1] += ch.upOffset[u];
+        ch.bwOffset[u + 1] += ch.bwOffset[u];
+    }
+    ch.upTarget.resize(ch.upOffset[n]);
+    ch.upWeight.resize(ch.upOffset[n]);
+    ch.upMid.resize(ch.upOffset[n]);
+    ch.bwTarget.resize(ch.bwOffset[n]);
+    ch.bwWeight.resize(ch.bwOffset[n]);
+    ch.bwMid.resize(ch.bwOffset[n]);
+    for (uint32_t u = 0; u < n; u++) {
+        uint32_t k = ch.upOffset[u];
+        for (auto& a : c.out[u]) {
+            if (ch.rank[a.to] <= ch.rank[u]) continue;
+            ch.upTarget[k] = a.to; ch.upWeight[k] = a.w; ch.upMid[k] = a.mid; k++;
+        }
+        k = ch.bwOffset[u];
+        for (auto& a : c.in[u]) {
+            if (ch.rank[a.to] <= ch.rank[u]) continue;
+            ch.bwTarget[k] = a.to; ch.bwWeight[k] = a.w; ch.bwMid[k] = a.mid; k++;
+        }
+    }
+    return ch;
+}
+
+/* =========================================================
+   CH  :    ö󰡴  Ž
+   - stall-on-demand :   带   ª    Ȯ 
+   ========================================================= */
+double chQuery(const CHGraph& ch, BidirectionalWorkspace& ws, uint32_t start, uint32_t goal) {
+    auto& F = ws.fwd;
+    auto& B = ws.bwd;
+    uint32_t n = ch.numNodes();
+    if (F.size() != n) F.resize(n);
+    if (B.size() != n) B.resize(n);
+    F.reset();
+    B.reset();
+
+    double best = INF_DIST;
+    ws.meet = INVALID_NODE;
+
+    F.set(start, 0, INVALID_NODE);
+    F.queue.push(start, 0);
+    B.set(goal, 0, INVALID_NODE);
+    B.queue.push(goal, 0);
+
+    //    ܰ Ȯ
+    auto step = [&](SearchWorkspace& W, SearchWorkspace& O,
+                    const vector<uint32_t>& off, const vector<uint32_t>& tgt, const vector<double>& wt,
+                    const vector<uint32_t>& soff, const vector<uint32_t>& stgt, const vector<double>& swt) {
+        auto [d, u] = W.queue.pop();
+        if (d > W.dist(u)) return;
+
+        if (O.reached(u) && d + O.dist(u) < best) {
+            best = d + O.dist(u);
+            ws.meet = u;
+        }
+
+        // stall-on-demand
+        for (uint32_t k = soff[u]; k < soff[u + 1]; k++) {
+            if (W.dist(stgt[k]) + swt[k] < d) return;
+        }
+
+        for (uint32_t k = off[u]; k < off[u + 1]; k++) {
+            uint32_t v = tgt[k];
+            double nd = d + wt[k];
+            if (W.dist(v) > nd) {
+                W.set(v, nd, u);
+                W.queue.push(v, nd);
+            }
+        }
+    };
+
+    for (;;) {
+        double kf = F.queue.empty() ? INF_DIST : F.queue.top().first;
+        double kb = B.queue.empty() ? INF_DIST : B.queue.top().first;
+        if (kf >= best && kb >= best) break;
+        if (kf <= kb)
+            step(F, B, ch.upOffset, ch.upTarget, ch.upWeight, ch.bwOffset, ch.bwTarget, ch.bwWeight);
+        else
+            step(B, F, ch.bwOffset, ch.bwTarget, ch.bwWeight, ch.upOffset, ch.upTarget, ch.upWeight);
+    }
+    return best;
+}
+
+/* =========================================================
+   shortcut Ǯ
+   - u  v (mid m) = (u  m) + (m  v),    m  Ǿ 
+   ========================================================= */
+static uint32_t findArc(const vector<uint32_t>& off, const vector<uint32_t>& tgt, const vector<double>& wt,
+                        uint32_t at, uint32_t other) {
+    uint32_t best = INVALID_EDGE;
+    for (uint32_t k = off[at]; k < off[at + 1]; k++) {
+        if (tgt[k] == other && (best == INVALID_EDGE || wt[k] < wt[best])) best = k;
+    }
+    return best;
+}
+
+static void unpack(const CHGraph& ch, uint32_t u, uint32_t v, uint32_t mid, vector<uint32_t>& out) {
+    if (mid == INVALID_NODE) {
+        out.push_back(v);
+        return;
+    }
+    uint32_t a = findArc(ch.bwOffset, ch.bwTarget, ch.bwWeight, mid, u); // u  mid
+    uint32_t b = findArc(ch.upOffset, ch.upTarget, ch.upWeight, mid, v); // mid  v
+    unpack(ch, u, mid, ch.bwMid[a], out);
+    unpack(ch, mid, v, ch.upMid[b], out);
+}
+
+void chPath(const CHGraph& ch, const BidirectionalWorkspace& ws, vector<uint32_t>& out) {
+    out.clear();
+    if (ws.meet == INVALID_NODE) return;
+
+    // CH   : start ... meet ... goal
+    vector<uint32_t> up;
+    ws.fwd.path(ws.meet, up);
+    for (uint32_t cur = ws.bwd.prev(ws.meet); cur != INVALID_NODE; cur = ws.bwd.prev(cur)) up.push_back(cur);
+
+    out.push_back(up[0]);
+    for (size_t i = 1; i < up.size(); i++) {
+        uint32_t a = up[i - 1], b = up[i];
+        if (ch.rank[b] > ch.rank[a]) {
+            uint32_t k = findArc(ch.upOffset, ch.upTarget, ch.upWeight, a, b);
+            unpack(ch, a, b, ch.upMid[k], out);
+        } else {
+            uint32_t k = findArc(ch.bwOffset, ch.bwTarget, ch.bwWeight, b, a);
+            unpack(ch, a, b, ch.bwMid[k], out);
+        }
+    }
+}
+
+/* =========================================================
+   permuteCH :  ȣ ٲٰ arc    (庰 arc  )
+   ========================================================= */
+CHGraph permuteCH(const CHGraph& ch, const vector<uint32_t>& order) {
+    uint32_t n = ch.numNodes();
+    vector<uint32_t> newId(n);
+    for (uint32_t i = 0; i < n; i++) newId[order[i]] = i;
+    auto mapNode = [&newId](uint32_t u) { return u == INVALID_NODE ? INVALID_NODE : newId[u]; };
+
+    CHGraph r;
+    r.rank.resize(n);
+    r.upOffset.assign(n + 1, 0);
+    r.bwOffset.assign(n + 1, 0);
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t u = order[i];
+        r.rank[i] = ch.rank[u];
+        for (uint32_t k = ch.upOffset[u]; k < ch.upOffset[u + 1]; k++) {
+            r.upTarget.push_back(newId[ch.upTarget[k]]);
+            r.upMid.push_back(mapNode(ch.upMid[k]));
+            r.upWeight.push_back(ch.upWeight[k]);
+        }
+        for (uint32_t k = ch.bwOffset[u]; k < ch.bwOffset[u + 1]; k++) {
+            r.bwTarget.push_back(newId[ch.bwTarget[k]]);
+            r.bwMid.push_back(mapNode(ch.bwMid[k]));
+            r.bwWeight.push_back(ch.bwWeight[k]);
+        }
+        r.upOffset[i + 1] = (uint32_t)r.upTarget.size();
+        r.bwOffset[i + 1] = (uint32_t)r.bwTarget.size();
+    }
+    return r;
+}
+
+/* =========================================================
+    / б : "CH03" + //shortcut  + ׷  + 迭 
+   - CH02 :  ȣ ġ ׷  (CH01  ٽ ó)
+   - CH03 :     ߰ (   ٸ ׷ /   Ÿ)
+   ========================================================= */
+static const char CH_MAGIC[4] = { 'C', 'H', '0', '3' };
+
+//  ϳ  FNV-1a (Ʈ   ó 뿡 ϸ  )
+uint64_t graphFingerprint(const Graph& g, Span<double> weight) {
+    uint64_t h = 14695981039346656037ull;
+    auto mix = [&h](uint64_t x) { h = (h ^ x) * 1099511628211ull; };
+    for (uint32_t x : g.offset) mix(x);
+    for (uint32_t x : g.target) mix(x);
+    for (double w : weight) {
+        uint64_t bits;
+        memcpy(&bits, &w, sizeof(bits));
+        mix(bits);
+    }
+    return h;
+}
+
+template <class T>
+static void writeVec(ofstream& f, const vector<T>& v) {
+    f.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T));
+}
+
+template <class T>
+static bool readVec(ifstream& f, vector<T>& v, size_t n) {
+    v.resize(n);
+    f.read(reinterpret_cast<char*>(v.data()), n * sizeof(T));
+    return (bool)f;
+}
+
+bool saveCH(const CHGraph& ch, const string& file, const Graph& g, Span<double> weight) {
+    ofstream f(file, ios::binary);
+    if (!f) return false;
+    uint32_t hdr[4] = { ch.numNodes(), g.numEdges(), (uint32_t)ch.upTarget.size(), (uint32_t)ch.bwTarget.size() };
+    uint64_t fp = graphFingerprint(g, weight);
+    f.write(CH_MAGIC, 4);
+    f.write(reinterpret_cast<const char*>(hdr), sizeof(hdr));
+    f.write(reinterpret_cast<const char*>(&fp), sizeof(fp));
+    writeVec(f, ch.rank);
+    writeVec(f, ch.upOffset); writeVec(f, ch.upTarget); writeVec(f, ch.upMid); writeVec(f, ch.upWeight);
+    writeVec(f, ch.bwOffset); writeVec(f, ch.bwTarget); writeVec(f, ch.bwMid); writeVec(f, ch.bwWeight);
+    return (bool)f;
+}
+
+bool loadCH(CHGraph& ch, const string& file, const Graph& g, Span<double> weight) {
+    ifstream f(file, ios::binary);
+    if (!f) return false;
+    char magic[4];
+    uint32_t hdr[4];
+    uint64_t fp;
+    f.read(magic, 4);
+    f.read(reinterpret_cast<char*>(hdr), sizeof(hdr));
+    f.read(reinterpret_cast<char*>(&fp), sizeof(fp));
+    if (!f || !equal(magic, magic + 4, CH_MAGIC)) return false;
+    if (hdr[0] != g.numNodes() || hdr[1] != g.numEdges() || fp != graphFingerprint(g, weight)) return false;
+
+    uint32_t n = hdr[0], mu = hdr[2], mb = hdr[3];
+    return readVec(f, ch.rank, n)
+        && readVec(f, ch.upOffset, n + 1) && readVec(f, ch.upTarget, mu)
+        && readVec(f, ch.upMid, mu) && readVec(f, ch.upWeight, mu)
+        && readVec(f, ch.bwOffset, n + 1) && readVec(f, ch.bwTarget, mb)
+        && readVec(f, ch.bwMid, mb) && readVec(f, ch.bwWeight, mb);
+}
@@ -0,0 +1,63 @@
+/*
+ ch.h : Contraction Hierarchies (CH)
+  - buildCH()  :   ϰ shortcut  ߰ϴ  ó ()
+  - chQuery()  :  ö󰡴  󰡴  Ž
+  - chPath()   : shortcut    η Ǯ (toDash ¿)
+  - saveCH() / loadCH() : ó  ̳ʸ Ϸ /б
+      ( ׷ /  +  Բ   ׷  ٲ   )
+  - permuteCH() : ׷ permuteNodes()  ġ    CH ȣ 
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "graph.h"
+#include "search.h"
+
+/* ================================
+   CHGraph : ó  ׷
+   - rank[u] :   (Ŭ ߿ )
+   - up  : u  v (rank[v] > rank[u])  , u  CSR
+   - bw  : x  v (rank[x] > rank[v])  v   (backward Ž)
+   - mid : shortcut  ߰  ( ̸ INVALID_NODE)
+   ================================ */
+struct CHGraph {
+    std::vector<uint32_t> rank;
+
+    std::vector<uint32_t> upOffset, upTarget, upMid;
+    std::vector<double> upWeight;
+
+    std::vector<uint32_t> bwOffset, bwTarget, bwMid;
+    std::vector<double> bwWeight;
+
+    uint32_t numNodes() const { return (uint32_t)rank.size(); }
+    uint32_t numShortcuts() const;
+};
+
+struct CHOptions {
+    unsigned threads = 0;          // 0 ̸ hardware_concurrency
+    uint32_t witnessSettle = 500;  //    witness Ž ִ settle  
+    uint32_t prioritySettle = 50;  // 켱 ( )  ִ settle  
+};
+
+// weight[e] : Graph  e   (, ð )
+CHGraph buildCH(const Graph& g, Span<double> weight, const CHOptions& opt = CHOptions());
+
+//  upward Ž  start  goal  ( Ұ INF_DIST), ws.meet   
+double chQuery(const CHGraph& ch, BidirectionalWorkspace& ws, uint32_t start, uint32_t goal);
+
+//  chQuery    η 
+void chPath(const CHGraph& ch, const BidirectionalWorkspace& ws, std::vector<uint32_t>& out);
+
+// order[ ȣ] =  ȣ (permuteNodes   迭),  ״
+//   ġ : g = permuteNodes(g, rankOrder(ch.rank))  Բ ch = permuteCH(ch,  order)
+CHGraph permuteCH(const CHGraph& ch, const std::vector<uint32_t>& order);
+
+// ó  ׷ /   : offset, target, weight  64 Ʈ FNV-1a  
+uint64_t graphFingerprint(const Graph& g, Span<double> weight);
+
+// g / weight : ó  ׷  (  塤   ٸ false  ٽ ó)
+bool saveCH(const CHGraph& ch, const std::string& file, const Graph& g, Span<double> weight);
+bool loadCH(CHGraph& ch, const std::string& file, const Graph& g, Span<double> weight);
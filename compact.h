@@ -0,0 +1,236 @@
+/*
+ compact.h : 32 Ʈ  Ž  (Ҽ uint32 / float)
+  -   ø  W (FixedWeight<> / FloatWeight)   롤dist  8  4 Ʈ
+  - CompactGraph<W> : ׷ offset / target  ״  븸 W::Key 迭  (庰   )
+  - compactDijkstra() : 4 Ʈ  / dist  ȭ (޸ 뿪, ĳÿ  ׷ ũ 2 )
+      COMPACT_SIMD     4  SSE2  (dist[u] + w) < dist[v] , پ ĭ 
+      (AVX2  dist[target]  gather  )    θ Į   ⺻ 
+  - Ҽ RadixHeap32  Ȯ radix ť (double + QuadHeap   20% ), float  QuadHeap
+  - ȯ  double  ǵ (Ҽ  1/ ݿø, float  ȿ 24 Ʈ)
+  - ۾   ȣ  ̹ ǿ ǵ帰   ʱȭ (SIMD 񱳿 dist  ʿ)
+*/
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#include "graph.h"
+#include "heap.h"
+#include "search.h"
+
+/* ================================
+   FixedWeight<UNIT> :   UNIT  ݿø uint32
+   - FixedWeight<100> :   cm (ִ  21,000 km), FixedWeight<10> :   0.1 
+   - INF = 2^31 - 1 : Ȯ  +   (  INF )  32 Ʈ  
+   ================================ */
+template <uint32_t UNIT>
+struct FixedWeight {
+    using Key = uint32_t;
+    using Queue = RadixHeap32;
+    static constexpr Key INF = 0x7FFFFFFFu;
+
+    static Key encode(double cost) {
+        if (!(cost < INF_DIST)) return INF;
+        double q = std::round(cost * UNIT);
+        return q >= INF ? INF : (Key)std::max(q, 0.0);
+    }
+    static double decode(Key k) { return k >= INF ? INF_DIST : (double)k / UNIT; }
+};
+
+/* ================================
+   FloatWeight : float  (INF = +Ѵ, ص Ѵ)
+   ================================ */
+struct FloatWeight {
+    using Key = float;
+    using Queue = QuadHeap;
+    static constexpr Key INF = std::numeric_limits<float>::infinity();
+
+    static Key encode(double cost) { return cost < INF_DIST ? (Key)cost : INF; }
+    static double decode(Key k) { return k == INF ? INF_DIST : (double)k; }
+};
+
+/* ================================
+   CompactGraph<W> : Ž   迭 (׷  ü  ƾ )
+   ================================ */
+template <class W>
+struct CompactGraph {
+    using Key = typename W::Key;
+
+    CompactGraph(const Graph& g, Span<double> weight) : offset(g.offset), target(g.target), cost(weight.size()) {
+        for (size_t e = 0; e < weight.size(); e++) cost[e] = W::encode(weight[e]);
+    }
+    explicit CompactGraph(const Graph& g) : CompactGraph(g, Span<double>(g.length)) {}
+
+    uint32_t numNodes() const { return (uint32_t)offset.size() - 1; }
+    size_t memoryBytes() const { return cost.size() * sizeof(Key); }
+
+    Span<uint32_t> offset, target;
+    std::vector<Key> cost;
+};
+
+/* ================================
+   CompactWorkspace<W, Queue> : 32 Ʈ dist + prev
+   - reset()   ǿ ǵ帰 常 INF  ǵ  O(ǵ帰 )
+   ================================ */
+template <class W, class Queue = typename W::Queue>
+class CompactWorkspace {
+public:
+    using Key = typename W::Key;
+
+    CompactWorkspace() = default;
+    explicit CompactWorkspace(uint32_t n) { resize(n); }
+
+    void resize(uint32_t n) {
+        queue.resize(n);
+        dist_.assign(n, W::INF);
+        prev_.assign(n, INVALID_NODE);
+        touched_.clear();
+    }
+    uint32_t size() const { return (uint32_t)dist_.size(); }
+
+    void reset() {
+        queue.clear();
+        for (uint32_t u : touched_) {
+            dist_[u] = W::INF;
+            prev_[u] = INVALID_NODE;
+        }
+        touched_.clear();
+    }
+
+    Key key(uint32_t u) const { return dist_[u]; }
+    double dist(uint32_t u) const { return W::decode(dist_[u]); }
+    bool reached(uint32_t u) const { return dist_[u] != W::INF; }
+    uint32_t prev(uint32_t u) const { return prev_[u]; }
+
+    void set(uint32_t u, Key d, uint32_t p) {
+        if (dist_[u] == W::INF) touched_.push_back(u);
+        dist_[u] = d;
+        prev_[u] = p;
+    }
+
+    void path(uint32_t goal, std::vector<uint32_t>& out) const {
+        out.clear();
+        if (!reached(goal)) return;
+        for (uint32_t cur = goal; cur != INVALID_NODE; cur = prev_[cur]) out.push_back(cur);
+        std::reverse(out.begin(), out.end());
+    }
+
+    const Key* distData() const { return dist_.data(); }
+
+    Queue queue;
+
+private:
+    std::vector<Key> dist_;
+    std::vector<uint32_t> prev_;
+    std::vector<uint32_t> touched_;
+};
+
+/* -----------------------------------------
+   relaxMask :  k..k+3  cd + cost < dist[target]  ĭ Ʈ (nd  4 ĭ  )
+   - uint32  ȣ Ʈ  ȣ ִ 񱳷 (SSE2  ȣ   )
+   ----------------------------------------- */
+inline unsigned relaxMask(const uint32_t* cost, const uint32_t* target, const uint32_t* dist, uint32_t cd,
+                          uint32_t* nd) {
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128i bias = _mm_set1_epi32((int)0x80000000u);
+    __m128i a = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cost)), _mm_set1_epi32((int)cd));
+#if defined(__AVX2__)
+    __m128i b = _mm_i32gather_epi32(reinterpret_cast<const int*>(dist),
+                                     _mm_loadu_si128(reinterpret_cast<const __m128i*>(target)), 4);
+#else
+    __m128i b = _mm_set_epi32((int)dist[target[3]], (int)dist[target[2]], (int)dist[target[1]], (int)dist[target[0]]);
+#endif
+    __m128i lt = _mm_cmplt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(nd), a);
+    return (unsigned)_mm_movemask_ps(_mm_castsi128_ps(lt));
+#else
+    unsigned mask = 0;
+    for (unsigned l = 0; l < 4; l++) {
+        nd[l] = cd + cost[l];
+        if (nd[l] < dist[target[l]]) mask |= 1u << l;
+    }
+    return mask;
+#endif
+}
+
+inline unsigned relaxMask(const float* cost, const uint32_t* target, const float* dist, float cd, float* nd) {
+#if defined(__SSE2__) || defined(_M_X64)
+    __m128 a = _mm_add_ps(_mm_loadu_ps(cost), _mm_set1_ps(cd));
+#if defined(__AVX2__)
+    __m128 b = _mm_i32gather_ps(dist, _mm_loadu_si128(reinterpret_cast<const __m128i*>(target)), 4);
+#else
+    __m128 b = _mm_set_ps(dist[target[3]], dist[target[2]], dist[target[1]], dist[target[0]]);
+#endif
+    _mm_storeu_ps(nd, a);
+    return (unsigned)_mm_movemask_ps(_mm_cmplt_ps(a, b));
+#else
+    unsigned mask = 0;
+    for (unsigned l = 0; l < 4; l++) {
+        nd[l] = cd + cost[l];
+        if (nd[l] < dist[target[l]]) mask |= 1u << l;
+    }
+    return mask;
+#endif
+}
+
+/* =========================================================
+   compactDijkstra : start  goal (goal  INVALID_NODE  ü)
+   - ȯ : double  ǵ  ( Ұ INF_DIST), δ ws.path(goal, out)
+   - COMPACT_SIMD :     4     پ ĭ Į ٽ Ȯ  
+     (   target      ° ٽ Ȯο ɷ)
+   ========================================================= */
+template <class W, class Queue>
+double compactDijkstra(const CompactGraph<W>& g, CompactWorkspace<W, Queue>& ws, uint32_t start, uint32_t goal) {
+    using Key = typename W::Key;
+    if (ws.size() != g.numNodes()) ws.resize(g.numNodes());
+    ws.reset();
+
+    auto& pq = ws.queue;
+    const Key* dist = ws.distData();
+    const uint32_t* target = g.target.begin();
+    const Key* cost = g.cost.data();
+    ws.set(start, 0, INVALID_NODE);
+    pq.push(start, 0);
+
+#ifdef COMPACT_SIMD
+    Key nd[4];
+#endif
+    while (!pq.empty()) {
+        auto [top, u] = pq.pop();
+        Key cd = (Key)top;
+        if (cd > dist[u]) continue;
+        if (u == goal) break;
+
+        uint32_t k = g.offset[u], end = g.offset[u + 1];
+#ifdef COMPACT_SIMD
+        for (; k + 4 <= end; k += 4) {
+            unsigned mask = relaxMask(cost + k, target + k, dist, cd, nd);
+            for (unsigned l = 0; mask; l++, mask >>= 1) {
+                if (!(mask & 1)) continue;
+                uint32_t v = target[k + l];
+                if (nd[l] < dist[v]) {
+                    ws.set(v, nd[l], u);
+                    pq.push(v, nd[l]);
+                }
+            }
+        }
+#endif
+        for (; k < end; k++) {
+            uint32_t v = target[k];
+            Key d = cd + cost[k];
+            if (d < dist[v]) {
+                ws.set(v, d, u);
+                pq.push(v, d);
+            }
+        }
+    }
+    return goal == INVALID_NODE ? 0 : ws.dist(goal);
+}
@@ -0,0 +1,60 @@
+/*
+ delay.h : ȣ / ȸ   ( α׷ )
+  - node[v] :  v    ȣ  ()
+  - edge[e] :  e (from  to)    ߰  (⺰ ȣ, ȸ )
+  -  ȣ /  ȣ ٷ ϴ ź 迭  ȸ O(1), б 
+  -  e   = edge[e] + node[target[e]]
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "graph.h"
+
+struct DelayTable {
+    std::vector<double> node; // ũ n
+    std::vector<double> edge; // ũ m
+
+    void reset(const Graph& g) {
+        node.assign(g.numNodes(), 0.0);
+        edge.assign(g.numEdges(), 0.0);
+        count = 0;
+    }
+
+    void setNode(uint32_t v, double d) {
+        node[v] = d;
+        count++;
+    }
+
+    // u  v   (  ),  false
+    bool setEdge(const Graph& g, uint32_t u, uint32_t v, double d) {
+        bool found = false;
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+            if (g.target[e] == v) {
+                edge[e] = d;
+                found = true;
+            }
+        }
+        count += found;
+        return found;
+    }
+
+    //  ϳ Ǿ (ó ĳ   Ǵܿ)
+    bool empty() const { return count == 0; }
+
+    double operator()(const Graph& g, uint32_t e) const { return edge[e] + node[g.target[e]]; }
+
+    //  θ    
+    double along(const Graph& g, const std::vector<uint32_t>& path) const {
+        double sum = 0;
+        for (size_t i = 1; i < path.size(); i++) {
+            uint32_t e = g.findEdge(path[i - 1], path[i]);
+            if (e != INVALID_EDGE) sum += (*this)(g, e);
+        }
+        return sum;
+    }
+
+private:
+    size_t count = 0;
+};
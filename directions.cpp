@@ -0,0 +1,75 @@
+#include "directions.h"
+
+#include <cmath>
+#include <cstdio>
+
+using namespace std;
+
+static constexpr double DEG = 3.14159265358979323846 / 180.0;
+
+// u  v  (,  0 /  90)
+static double bearing(const Graph& g, uint32_t u, uint32_t v) {
+    double dy = g.lat[v] - g.lat[u];
+    double dx = (g.lon[v] - g.lon[u]) * cos(g.lat[u] * DEG);
+    return atan2(dx, dy) / DEG;
+}
+
+static TurnDirection classify(double from, double to, bool reverse) {
+    if (reverse) return TURN_UTURN;
+    double d = to - from;
+    if (d > 180) d -= 360;
+    if (d <= -180) d += 360;
+    double a = fabs(d);
+    if (a <= 30) return TURN_STRAIGHT;
+    if (a >= 170) return TURN_UTURN;
+    return d > 0 ? TURN_RIGHT : TURN_LEFT;
+}
+
+/* =========================================================
+    
+   - θ ٲ  , ̸  γ   ̾ 
+   ========================================================= */
+void describeRoute(const Graph& g, const vector<uint32_t>& path, vector<RouteStep>& steps) {
+    steps.clear();
+    double prevBearing = 0;
+    for (size_t i = 1; i < path.size(); i++) {
+        uint32_t u = path[i - 1], v = path[i];
+        uint32_t e = g.findEdge(u, v);
+        if (e == INVALID_EDGE) continue;
+        uint32_t road = g.attr.roadId[e];
+        double b = bearing(g, u, v);
+
+        TurnDirection turn = TURN_DEPART;
+        if (!steps.empty()) turn = classify(prevBearing, b, i >= 2 && path[i - 2] == v);
+        bool same = !steps.empty() && steps.back().road == road && turn != TURN_UTURN
+            && (road != 0 || turn == TURN_STRAIGHT);
+        if (same) {
+            steps.back().length += g.length[e];
+        } else {
+            steps.push_back({ u, road, g.attr.highway[e], turn, g.length[e] });
+        }
+        prevBearing = b;
+    }
+}
+
+vector<string> formatDirections(const Graph& g, const vector<RouteStep>& steps) {
+    static const char* const VERB[] = { "Head", "Continue", "Turn right", "Turn left", "Make a U-turn" };
+    vector<string> lines;
+    for (const RouteStep& s : steps) {
+        string line = VERB[s.turn];
+        string_view name = g.attr.road(s.road);
+        if (!name.empty()) {
+            line += s.turn == TURN_DEPART ? " on " : " onto ";
+            line += name;
+        } else if (s.highway != HW_UNKNOWN) {
+            line += s.turn == TURN_DEPART ? " on " : " onto ";
+            line += highwayName(s.highway);
+            line += " road";
+        }
+        char buf[32];
+        snprintf(buf, sizeof(buf), " (%.0f m)", s.length);
+        lines.push_back(line + buf);
+    }
+    if (!steps.empty()) lines.push_back("Arrive at destination");
+    return lines;
+}
@@ -0,0 +1,34 @@
+/*
+ directions.h :  ȳ (   Ӽ ǥ )
+  - describeRoute() :     ΰ ̾ (RouteStep) 
+  - formatDirections() : "Turn left onto Jong-ro (350 m)"  
+  - ȸ        Ǵ (  )
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "graph.h"
+
+enum TurnDirection : uint8_t { TURN_DEPART, TURN_STRAIGHT, TURN_RIGHT, TURN_LEFT, TURN_UTURN };
+
+/* ================================
+   RouteStep :  (roadId) ̾  
+   - node   :  ۵Ǵ  (path   ȣ)
+   - turn   :     ȸ (ù  TURN_DEPART)
+   - length :   ()
+   ================================ */
+struct RouteStep {
+    uint32_t node;
+    uint32_t road;
+    uint8_t highway;
+    TurnDirection turn;
+    double length;
+};
+
+void describeRoute(const Graph& g, const std::vector<uint32_t>& path, std::vector<RouteStep>& steps);
+
+//   =  ,   
+std::vector<std::string> formatDirections(const Graph& g, const std::vector<RouteStep>& steps);
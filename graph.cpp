@@ -0,0 +1,934 @@
+#include "graph.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+#include "tinyxml2.h"
+
+using namespace std;
+using namespace tinyxml2;
+
+/* =========================================================
+   Haversine Ÿ  (lat/lon  meter)
+   ========================================================= */
+double haversine(double lat1, double lon1, double lat2, double lon2) {
+    auto rad = [](double d) { return d * M_PI / 180.0; };
+    double dlat = rad(lat2 - lat1), dlon = rad(lon2 - lon1);
+    double a = sin(dlat / 2) * sin(dlat / 2)
+        + cos(rad(lat1)) * cos(rad(lat2)) * sin(dlon / 2) * sin(dlon / 2);
+    return 2 * EARTH_R * atan2(sqrt(a), sqrt(1 - a));
+}
+
+/* =========================================================
+   Equirectangular ٻ Ÿ
+   ========================================================= */
+double equirectangular(double lat1, double lon1, double lat2, double lon2) {
+    constexpr double DEG = M_PI / 180.0;
+    double x = (lon2 - lon1) * DEG * cos((lat1 + lat2) * 0.5 * DEG);
+    double y = (lat2 - lat1) * DEG;
+    return EARTH_R * sqrt(x * x + y * y);
+}
+
+/* =========================================================
+     (OSM highway ±)
+   ========================================================= */
+static const char* const HIGHWAY_NAMES[HW_COUNT] = {
+    "", "motorway", "trunk", "primary", "secondary", "tertiary",
+    "unclassified", "residential", "living_street", "service", "other"
+};
+
+// OSMnx    Ӽ "['a', 'b']"    ù 
+static string_view firstListItem(string_view v) {
+    size_t b = v.find_first_not_of("[ '\"");
+    if (b == string_view::npos) return {};
+    size_t e = v.find_first_of(",]'\"", b);
+    v = v.substr(b, e == string_view::npos ? string_view::npos : e - b);
+    while (!v.empty() && v.back() == ' ') v.remove_suffix(1);
+    return v;
+}
+
+HighwayClass highwayClass(string_view tag) {
+    string_view v = firstListItem(tag);
+    if (v.empty()) return HW_UNKNOWN;
+    if (v.size() > 5 && v.substr(v.size() - 5) == "_link") v.remove_suffix(5); // δ  
+    for (int k = 1; k < HW_OTHER; k++)
+        if (v == HIGHWAY_NAMES[k]) return (HighwayClass)k;
+    return HW_OTHER;
+}
+
+const char* highwayName(uint8_t hw) {
+    return hw < HW_COUNT ? HIGHWAY_NAMES[hw] : "";
+}
+
+static uint64_t parseWayId(string_view v) {
+    v = firstListItem(v);
+    uint64_t id = 0;
+    for (char ch : v) {
+        if (ch < '0' || ch > '9') break;
+        id = id * 10 + (uint64_t)(ch - '0');
+    }
+    return id;
+}
+
+/* =========================================================
+   Graph ȸ
+   ========================================================= */
+uint32_t Graph::find(string_view key) const {
+    auto it = lower_bound(idSorted.begin(), idSorted.end(), key,
+        [this](uint32_t u, string_view k) { return id(u) < k; });
+    if (it == idSorted.end() || id(*it) != key) return INVALID_NODE;
+    return *it;
+}
+
+uint32_t Graph::findEdge(uint32_t u, uint32_t v) const {
+    uint32_t best = INVALID_EDGE;
+    for (uint32_t e = edgeBegin(u); e < edgeEnd(u); e++) {
+        if (target[e] == v && (best == INVALID_EDGE || length[e] < length[best])) best = e;
+    }
+    return best;
+}
+
+void Graph::buildReverse() {
+    uint32_t n = numNodes(), m = numEdges();
+    vector<uint32_t> off(n + 1, 0), src(m), edge(m);
+
+    for (uint32_t e = 0; e < m; e++) off[target[e] + 1]++;
+    for (uint32_t v = 0; v < n; v++) off[v + 1] += off[v];
+
+    vector<uint32_t> pos(off.begin(), off.end() - 1);
+    for (uint32_t u = 0; u < n; u++) {
+        for (uint32_t e = edgeBegin(u); e < edgeEnd(u); e++) {
+            uint32_t k = pos[target[e]]++;
+            src[k] = u;
+            edge[k] = e;
+        }
+    }
+    rOffset = move(off);
+    rSource = move(src);
+    rEdge = move(edge);
+}
+
+/* =========================================================
+   GraphBuilder
+   ========================================================= */
+uint32_t GraphBuilder::intern(string_view id) {
+    uint32_t u = ids.intern(id);
+    if (u < nodeLat.size()) return u;
+
+    nodeLat.push_back(0.0);
+    nodeLon.push_back(0.0);
+    declared.push_back(0);
+    return u;
+}
+
+uint32_t GraphBuilder::addNode(string_view id, double lat, double lon) {
+    uint32_t u = intern(id);
+    nodeLat[u] = lat;
+    nodeLon[u] = lon;
+    declared[u] = 1;
+    return u;
+}
+
+void GraphBuilder::addEdge(uint32_t s, uint32_t t, double length, string_view road, bool oneway, uint64_t wayId,
+                           uint8_t highway) {
+    // θ intern (0   ̸)
+    if (roads.size() == 0) roads.intern(string_view());
+    uint32_t r = roads.intern(road);
+    edges.push_back({ s, t, length, wayId, r, highway, oneway });
+}
+
+// ڿ Ǯ  (offset, chars) ̺ (  ۸ ״ ѱ)
+static void releaseStrings(StringPool& pool, Array<uint32_t>& offset, Array<char>& chars) {
+    vector<uint32_t> off;
+    vector<char> buf;
+    pool.release(off, buf);
+    offset = move(off);
+    chars = move(buf);
+}
+
+Graph GraphBuilder::build() {
+    Graph g;
+    uint32_t n = (uint32_t)ids.size();
+    uint32_t m = (uint32_t)edges.size();
+
+    // 0)    : ǥ  (ǥ  忡  0)
+    for (auto& e : edges) {
+        if (!isnan(e.length)) continue;
+        e.length = (declared[e.s] && declared[e.t])
+            ? haversine(nodeLat[e.s], nodeLon[e.s], nodeLat[e.t], nodeLon[e.t]) : 0.0;
+    }
+
+    g.lat = move(nodeLat);
+    g.lon = move(nodeLon);
+
+    // 1) id / θ ڿ ̺
+    if (roads.size() == 0) roads.intern(string_view());
+    releaseStrings(ids, g.idOffset, g.idChars);
+    releaseStrings(roads, g.attr.roadOffset, g.attr.roadChars);
+
+    g.idSorted.resize(n);
+    for (uint32_t u = 0; u < n; u++) g.idSorted[u] = u;
+    sort(g.idSorted.begin(), g.idSorted.end(),
+        [&g](uint32_t a, uint32_t b) { return g.id(a) < g.id(b); });
+
+    // 2) CSR :  庰      Է  ġ
+    g.offset.assign(n + 1, 0);
+    for (auto& e : edges) g.offset[e.s + 1]++;
+    for (uint32_t u = 0; u < n; u++) g.offset[u + 1] += g.offset[u];
+
+    g.target.resize(m);
+    g.length.resize(m);
+    g.attr.roadId.resize(m);
+    g.attr.wayId.resize(m);
+    g.attr.highway.resize(m);
+    g.attr.oneway.resize(m);
+    vector<uint32_t> pos(g.offset.begin(), g.offset.end() - 1);
+    for (auto& e : edges) {
+        uint32_t k = pos[e.s]++;
+        g.target[k] = e.t;
+        g.length[k] = e.length;
+        g.attr.roadId[k] = e.road;
+        g.attr.wayId[k] = e.wayId;
+        g.attr.highway[k] = e.highway;
+        g.attr.oneway[k] = e.oneway;
+    }
+
+    // 3)  CSR
+    g.buildReverse();
+
+    // ε  ۴    (ڿ Ǯ  ̹ Ѱ)
+    vector<uint8_t>().swap(declared);
+    vector<RawEdge>().swap(edges);
+    return g;
+}
+
+/* =========================================================
+   XML ± ̸ namespace  (node, edge  )
+   ========================================================= */
+static string localName(const char* name) {
+    if (!name) return "";
+    string s = name;
+    size_t p = s.find_last_of(":}");
+    return (p != string::npos) ? s.substr(p + 1) : s;
+}
+
+/* =========================================================
+   GraphML  ε (tinyxml2 DOM)
+   - d4 = latitude
+   - d5 = longitude
+   - d16 = length
+   - d13 = road name
+   - osmid / highway / oneway  attr.name  ã
+   ========================================================= */
+bool loadGraphMLDom(const string& file, Graph& g, const GraphMLOptions& opt) {
+    XMLDocument doc;
+    if (doc.LoadFile(file.c_str()) != XML_SUCCESS) return false;
+    XMLElement* root = doc.RootElement();
+    if (!root) return false;
+
+    unordered_map<string, string> keyIdToName; // GraphML key id  field name (d4 = lat )
+    GraphBuilder b;
+
+    // 1) <key> ± о keyIdToName 
+    for (auto* key = root->FirstChildElement(); key; key = key->NextSiblingElement()) {
+        if (localName(key->Name()) != "key") continue;
+        const char* id = key->Attribute("id");
+        const char* attr = key->Attribute("attr.name");
+        if (id && attr) keyIdToName[id] = attr;
+    }
+
+    // 2) <graph> ± ã
+    XMLElement* graph = nullptr;
+    for (auto* c = root->FirstChildElement(); c; c = c->NextSiblingElement()) {
+        if (localName(c->Name()) == "graph") graph = c;
+    }
+    if (!graph) graph = root; // fallback
+
+    // 3)  Ľ
+    for (auto* n = graph->FirstChildElement(); n; n = n->NextSiblingElement()) {
+        if (localName(n->Name()) != "node") continue;
+
+        const char* id = n->Attribute("id");
+        if (!id) continue;
+
+        double lat = 0.0, lon = 0.0;
+        for (auto* d = n->FirstChildElement(); d; d = d->NextSiblingElement()) {
+            if (localName(d->Name()) != "data") continue;
+            const char* key = d->Attribute("key");
+            const char* text = d->GetText();
+            if (!key || !text) continue;
+
+            string attr = keyIdToName[key];
+            double v = atof(text);
+
+            if (attr == "lat" || attr == "y" || key == string("d4"))
+                lat = v;
+            else if (attr == "lon" || attr == "x" || key == string("d5"))
+                lon = v;
+        }
+        b.addNode(id, lat, lon);
+    }
+
+    // 4)  Ľ
+    for (auto* e = graph->FirstChildElement(); e; e = e->NextSiblingElement()) {
+        if (localName(e->Name()) != "edge") continue;
+
+        const char* s = e->Attribute("source");
+        const char* t = e->Attribute("target");
+        if (!s || !t) continue;
+
+        double length = NAN;
+        string road;
+        string oneway;
+        uint64_t wayId = 0;
+        uint8_t highway = HW_UNKNOWN;
+
+        //  data Ľ
+        for (auto* d = e->FirstChildElement(); d; d = d->NextSiblingElement()) {
+            if (localName(d->Name()) != "data") continue;
+
+            const char* key = d->Attribute("key");
+            const char* text = d->GetText();
+            if (!key || !text) continue;
+
+            string attr = keyIdToName[key];
+
+            if (attr == "length" || key == string("d16"))
+                length = atof(text);
+            else if (attr == "name" || key == string("d13"))
+                road = text;
+            else if (attr == "oneway")
+                oneway = text;
+            else if (attr == "osmid")
+                wayId = parseWayId(text);
+            else if (attr == "highway")
+                highway = highwayClass(text);
+        }
+
+        bool known = b.has(s) && b.has(t);
+        uint32_t su = b.intern(s), tu = b.intern(t);
+
+        // 4-1)   浵  
+        if (!opt.useLengthAttr || !isfinite(length)) {
+            length = known ? haversine(b.lat(su), b.lon(su), b.lat(tu), b.lon(tu)) : 0.0;
+        }
+
+        // 4-2) ⼺ ó (oneway true ܹ)
+        bool isOne = false;
+        if (opt.honourOneway && !oneway.empty()) {
+            string v = oneway;
+            transform(v.begin(), v.end(), v.begin(), ::tolower);
+            if (v == "true" || v == "yes" || v == "1") isOne = true;
+        }
+
+        b.addEdge(su, tu, length, road, isOne, wayId, highway);
+        if (!isOne) b.addEdge(tu, su, length, road, false, wayId, highway);
+    }
+
+    g = b.build();
+    if (opt.order != ORDER_INPUT) g = permuteNodes(g, nodeOrder(g, opt.order));
+    return true;
+}
+
+/* =========================================================
+   Ʈ GraphML б
+   - XmlReader :  ũ ۷  ݾ д ּ XML ũ
+                  ± /  ± / ؽƮ , ּPIDOCTYPE  ǳʶ
+                 ̸/Ӽ ڿ ۴   ±׸ Ҵ 
+   - <key>  д  ʵ ڵ ȯ, <data>  key  ڵ ȸ   б
+   ========================================================= */
+namespace {
+
+class XmlReader {
+public:
+    enum Token { END_OF_FILE, START_TAG, END_TAG, TEXT, ERROR };
+
+    string name;   // / ± ̸
+    string text;   // TEXT  (ƼƼ ؼ )
+    bool selfClosing = false;
+
+    explicit XmlReader(FILE* f) : file(f), buf(1 << 16) {}
+
+    Token next() {
+        for (;;) {
+            int c = peek();
+            if (c < 0) return END_OF_FILE;
+            if (c != '<') {
+                readText();
+                return TEXT;
+            }
+            pos++;
+            c = peek();
+            if (c == '/') {
+                pos++;
+                readName(name);
+                if (!skipPast(">")) return ERROR;
+                return END_TAG;
+            }
+            if (c == '?') {
+                if (!skipPast("?>")) return ERROR;
+                continue;
+            }
+            if (c == '!') {
+                pos++;
+                if (match("--")) {
+                    if (!skipPast("-->")) return ERROR;
+                    continue;
+                }
+                if (match("[CDATA[")) {
+                    text.clear();
+                    if (!readUntil("]]>", text)) return ERROR;
+                    return TEXT;
+                }
+                if (!skipDeclaration()) return ERROR;
+                continue;
+            }
+            return readStartTag() ? START_TAG : ERROR;
+        }
+    }
+
+    //   ± Ӽ  ( nullptr)
+    const string* attr(const char* key) const {
+        for (size_t i = 0; i < numAttrs; i++)
+            if (attrs[i].first == key) return &attrs[i].second;
+        return nullptr;
+    }
+
+private:
+    FILE* file;
+    vector<char> buf;
+    size_t pos = 0, end = 0;
+    vector<pair<string, string>> attrs;
+    size_t numAttrs = 0;
+
+    bool fill() {
+        pos = 0;
+        end = fread(buf.data(), 1, buf.size(), file);
+        return end > 0;
+    }
+    int peek() {
+        if (pos == end && !fill()) return -1;
+        return (unsigned char)buf[pos];
+    }
+    int get() {
+        int c = peek();
+        if (c >= 0) pos++;
+        return c;
+    }
+    static bool isSpace(int c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+    void skipSpace() {
+        while (isSpace(peek())) pos++;
+    }
+
+    //  ڵ s   Һ (պκи ° Ʋ ׸ŭ Һ ä false)
+    bool match(const char* s) {
+        for (; *s; s++) {
+            if (peek() != (unsigned char)*s) return false;
+            pos++;
+        }
+        return true;
+    }
+
+    // pat    о out  ߰ (pat  )
+    bool readUntil(const char* pat, string& out) {
+        size_t len = strlen(pat);
+        for (;;) {
+            int c = get();
+            if (c < 0) return false;
+            out.push_back((char)c);
+            if (out.size() >= len && out.compare(out.size() - len, len, pat) == 0) {
+                out.resize(out.size() - len);
+                return true;
+            }
+        }
+    }
+    bool skipPast(const char* pat) {
+        scratch.clear();
+        size_t len = strlen(pat);
+        for (;;) {
+            int c = get();
+            if (c < 0) return false;
+            scratch.push_back((char)c);
+            if (scratch.size() >= len && scratch.compare(scratch.size() - len, len, pat) == 0) return true;
+            if (scratch.size() > 64) scratch.erase(0, scratch.size() - len);
+        }
+    }
+    string scratch;
+
+    // <!DOCTYPE ...> :  [ ... ]  ؼ ǳʶ
+    bool skipDeclaration() {
+        int depth = 0;
+        for (;;) {
+            int c = get();
+            if (c < 0) return false;
+            if (c == '[') depth++;
+            else if (c == ']') depth--;
+            else if (c == '>' && depth <= 0) return true;
+        }
+    }
+
+    void readName(string& out) {
+        out.clear();
+        for (;;) {
+            int c = peek();
+            if (c < 0 || isSpace(c) || c == '/' || c == '>' || c == '=') return;
+            out.push_back((char)c);
+            pos++;
+        }
+    }
+
+    // &  ;  ؼؼ out  UTF-8  ߰
+    void readEntity(string& out) {
+        char ent[12];
+        size_t n = 0;
+        int c;
+        while ((c = peek()) >= 0 && c != ';' && n < sizeof(ent) - 1 && !isSpace(c) && c != '<') {
+            ent[n++] = (char)c;
+            pos++;
+        }
+        ent[n] = 0;
+        if (c != ';') {
+            out.push_back('&');
+            out.append(ent, n);
+            return;
+        }
+        pos++;
+        if (!strcmp(ent, "amp")) out.push_back('&');
+        else if (!strcmp(ent, "lt")) out.push_back('<');
+        else if (!strcmp(ent, "gt")) out.push_back('>');
+        else if (!strcmp(ent, "quot")) out.push_back('"');
+        else if (!strcmp(ent, "apos")) out.push_back('\'');
+        else if (ent[0] == '#') {
+            unsigned long cp = (ent[1] == 'x' || ent[1] == 'X') ? strtoul(ent + 2, nullptr, 16) : strtoul(ent + 1, nullptr, 10);
+            if (cp < 0x80) out.push_back((char)cp);
+            else if (cp < 0x800) {
+                out.push_back((char)(0xC0 | (cp >> 6)));
+                out.push_back((char)(0x80 | (cp & 0x3F)));
+            } else if (cp < 0x10000) {
+                out.push_back((char)(0xE0 | (cp >> 12)));
+                out.push_back((char)(0x80 | ((cp >> 6) & 0x3F)));
+                out.push_back((char)(0x80 | (cp & 0x3F)));
+            } else {
+                out.push_back((char)(0xF0 | (cp >> 18)));
+                out.push_back((char)(0x80 | ((cp >> 12) & 0x3F)));
+                out.push_back((char)(0x80 | ((cp >> 6) & 0x3F)));
+                out.push_back((char)(0x80 | (cp & 0x3F)));
+            }
+        } else {
+            out.push_back('&');
+            out.append(ent, n);
+            out.push_back(';');
+        }
+    }
+
+    void readText() {
+        text.clear();
+        for (;;) {
+            int c = peek();
+            if (c < 0 || c == '<') return;
+            pos++;
+            if (c == '&') readEntity(text);
+            else text.push_back((char)c);
+        }
+    }
+
+    bool readStartTag() {
+        readName(name);
+        numAttrs = 0;
+        selfClosing = false;
+        for (;;) {
+            skipSpace();
+            int c = get();
+            if (c < 0) return false;
+            if (c == '>') return true;
+            if (c == '/') {
+                selfClosing = true;
+                return get() == '>';
+            }
+            pos--;
+            if (numAttrs == attrs.size()) attrs.emplace_back();
+            auto& a = attrs[numAttrs++];
+            readName(a.first);
+            a.second.clear();
+            if (a.first.empty()) return false;
+            skipSpace();
+            if (get() != '=') return false;
+            skipSpace();
+            int q = get();
+            if (q != '"' && q != '\'') return false;
+            for (;;) {
+                c = get();
+                if (c < 0) return false;
+                if (c == q) break;
+                if (c == '&') readEntity(a.second);
+                else a.second.push_back((char)c);
+            }
+        }
+    }
+};
+
+// namespace ξ  (graphml:node  node)
+string_view localPart(const string& s) {
+    size_t p = s.find_last_of(":}");
+    return p == string::npos ? string_view(s) : string_view(s).substr(p + 1);
+}
+
+/* -----------------------------------------
+   GraphML key  ʵ ڵ (DOM δ  Ģ)
+   ----------------------------------------- */
+enum Field : uint8_t { F_NONE, F_LAT, F_LON, F_LENGTH, F_NAME, F_ONEWAY, F_WAY_ID, F_HIGHWAY };
+
+struct FieldCodes {
+    uint8_t node = F_NONE, edge = F_NONE;
+    bool known = false;
+};
+
+class KeyTable {
+public:
+    void declare(const string& id, const string& attrName) { slot(id) = codesFor(id, attrName); }
+
+    const FieldCodes& lookup(const string& id) {
+        FieldCodes& c = slot(id);
+        if (!c.known) c = codesFor(id, ""); //   key : ̸ Ģ 
+        return c;
+    }
+
+private:
+    vector<FieldCodes> byNumber;               // OSMnx  "d0", "d1", ...  迭 ٷ ȸ
+    unordered_map<string, FieldCodes> byName;  //   id
+
+    FieldCodes& slot(const string& id) {
+        if (id.size() >= 2 && id.size() <= 5 && id[0] == 'd'
+            && all_of(id.begin() + 1, id.end(), [](char ch) { return ch >= '0' && ch <= '9'; })) {
+            size_t k = (size_t)atoi(id.c_str() + 1);
+            if (k >= byNumber.size()) byNumber.resize(k + 1);
+            return byNumber[k];
+        }
+        return byName[id];
+    }
+
+    static FieldCodes codesFor(const string& key, const string& attr) {
+        FieldCodes c;
+        c.known = true;
+        if (attr == "lat" || attr == "y" || key == "d4") c.node = F_LAT;
+        else if (attr == "lon" || attr == "x" || key == "d5") c.node = F_LON;
+        if (attr == "length" || key == "d16") c.edge = F_LENGTH;
+        else if (attr == "name" || key == "d13") c.edge = F_NAME;
+        else if (attr == "oneway") c.edge = F_ONEWAY;
+        else if (attr == "osmid") c.edge = F_WAY_ID;
+        else if (attr == "highway") c.edge = F_HIGHWAY;
+        return c;
+    }
+};
+
+} // namespace
+
+/* =========================================================
+   GraphML  ε (Ʈ)
+   - ޸  : б  64KB + GraphBuilder  ̴ /
+   - /   GraphBuilder  ߰, ǥ  ̴ build()  
+   ========================================================= */
+bool loadGraphML(const string& file, Graph& g, const GraphMLOptions& opt) {
+    FILE* f = fopen(file.c_str(), "rb");
+    if (!f) return false;
+    XmlReader xml(f);
+    KeyTable keys;
+    GraphBuilder b;
+
+    enum { NONE, NODE, EDGE } elem = NONE; //  а ִ <node>/<edge>
+    int depth = 0, elemDepth = 0;
+    uint8_t field = F_NONE;               //  <data>  ʵ (F_NONE ̸ )
+    bool inData = false, sawRoot = false, ok = true;
+
+    string nodeId, source, target, road, oneway, value;
+    double lat = 0, lon = 0, length = NAN;
+    uint64_t wayId = 0;
+    uint8_t highway = HW_UNKNOWN;
+
+    auto finishElement = [&]() {
+        if (elem == NODE) {
+            b.addNode(nodeId, lat, lon);
+        } else if (elem == EDGE) {
+            uint32_t su = b.intern(source), tu = b.intern(target);
+            if (!opt.useLengthAttr || !isfinite(length)) length = NAN; // build()  ǥ 
+
+            bool isOne = false;
+            if (opt.honourOneway && !oneway.empty()) {
+                transform(oneway.begin(), oneway.end(), oneway.begin(), ::tolower);
+                if (oneway == "true" || oneway == "yes" || oneway == "1") isOne = true;
+            }
+            b.addEdge(su, tu, length, road, isOne, wayId, highway);
+            if (!isOne) b.addEdge(tu, su, length, road, false, wayId, highway);
+        }
+        elem = NONE;
+    };
+
+    auto finishData = [&]() {
+        inData = false;
+        if (value.empty()) return;
+        switch (field) {
+        case F_LAT: lat = atof(value.c_str()); break;
+        case F_LON: lon = atof(value.c_str()); break;
+        case F_LENGTH: length = atof(value.c_str()); break;
+        case F_NAME: road = value; break;
+        case F_ONEWAY: oneway = value; break;
+        case F_WAY_ID: wayId = parseWayId(value); break;
+        case F_HIGHWAY: highway = highwayClass(value); break;
+        default: break;
+        }
+    };
+
+    for (bool done = false; !done && ok;) {
+        switch (xml.next()) {
+        case XmlReader::END_OF_FILE:
+            done = true;
+            break;
+        case XmlReader::ERROR:
+            ok = false;
+            break;
+        case XmlReader::TEXT:
+            if (inData) value += xml.text;
+            break;
+        case XmlReader::START_TAG: {
+            sawRoot = true;
+            depth++;
+            string_view tag = localPart(xml.name);
+            if (tag == "key") {
+                const string* id = xml.attr("id");
+                const string* attrName = xml.attr("attr.name");
+                if (id && attrName) keys.declare(*id, *attrName);
+            } else if (tag == "node" && elem == NONE) {
+                const string* id = xml.attr("id");
+                if (id) {
+                    elem = NODE;
+                    elemDepth = depth;
+                    nodeId = *id;
+                    lat = lon = 0.0;
+                }
+            } else if (tag == "edge" && elem == NONE) {
+                const string* s = xml.attr("source");
+                const string* t = xml.attr("target");
+                if (s && t) {
+                    elem = EDGE;
+                    elemDepth = depth;
+                    source = *s;
+                    target = *t;
+                    length = NAN;
+                    road.clear();
+                    oneway.clear();
+                    wayId = 0;
+                    highway = HW_UNKNOWN;
+                }
+            } else if (tag == "data" && elem != NONE && depth == elemDepth + 1) {
+                const string* key = xml.attr("key");
+                if (key) {
+                    const FieldCodes& c = keys.lookup(*key);
+                    field = elem == NODE ? c.node : c.edge;
+                    inData = true;
+                    value.clear();
+                }
+            }
+            if (xml.selfClosing) {
+                if (inData) finishData();
+                if (elem != NONE && depth == elemDepth) finishElement();
+                depth--;
+            }
+            break;
+        }
+        case XmlReader::END_TAG:
+            if (inData && depth == elemDepth + 1) finishData();
+            if (elem != NONE && depth == elemDepth) finishElement();
+            depth--;
+            break;
+        }
+    }
+    fclose(f);
+    if (!ok || !sawRoot) return false;
+
+    g = b.build();
+    if (opt.order != ORDER_INPUT) g = permuteNodes(g, nodeOrder(g, opt.order));
+    return true;
+}
+
+/* =========================================================
+   Hilbert  
+   - ǥ    2^16 x 2^16 ڷ ȭ    Ÿ(d)  
+   -     鿡  (  迡  Z-order  Ҽ )
+   ========================================================= */
+static uint64_t hilbertIndex(uint32_t x, uint32_t y) {
+    const uint32_t N = 1u << 16;
+    uint64_t d = 0;
+    for (uint32_t s = N / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) ? 1 : 0, ry = (y & s) ? 1 : 0;
+        d += (uint64_t)s * s * ((3 * rx) ^ ry);
+        if (ry == 0) { // и ȸ
+            if (rx == 1) {
+                x = N - 1 - x;
+                y = N - 1 - y;
+            }
+            swap(x, y);
+        }
+    }
+    return d;
+}
+
+vector<uint32_t> hilbertOrder(const Graph& g) {
+    uint32_t n = g.numNodes();
+    vector<uint32_t> order(n);
+    iota(order.begin(), order.end(), 0);
+    if (n == 0) return order;
+
+    double minLat = *min_element(g.lat.begin(), g.lat.end()), maxLat = *max_element(g.lat.begin(), g.lat.end());
+    double minLon = *min_element(g.lon.begin(), g.lon.end()), maxLon = *max_element(g.lon.begin(), g.lon.end());
+    double sy = maxLat > minLat ? 65535.0 / (maxLat - minLat) : 0.0;
+    double sx = maxLon > minLon ? 65535.0 / (maxLon - minLon) : 0.0;
+
+    vector<uint64_t> key(n);
+    for (uint32_t u = 0; u < n; u++)
+        key[u] = hilbertIndex((uint32_t)((g.lon[u] - minLon) * sx), (uint32_t)((g.lat[u] - minLat) * sy));
+    stable_sort(order.begin(), order.end(), [&key](uint32_t a, uint32_t b) { return key[a] < key[b]; });
+    return order;
+}
+
+/* =========================================================
+   BFS  : / ̿  󰡴 ʺ 켱 ( )
+   -  Hilbert   湮  ù  ( Ҹ  )
+   ========================================================= */
+vector<uint32_t> bfsOrder(const Graph& g) {
+    uint32_t n = g.numNodes();
+    vector<uint32_t> order;
+    order.reserve(n);
+    vector<uint8_t> seen(n, 0);
+    for (uint32_t root : hilbertOrder(g)) {
+        if (seen[root]) continue;
+        seen[root] = 1;
+        order.push_back(root);
+        for (size_t head = order.size() - 1; head < order.size(); head++) {
+            uint32_t u = order[head];
+            for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++)
+                if (!seen[g.target[e]]) { seen[g.target[e]] = 1; order.push_back(g.target[e]); }
+            for (uint32_t k = g.inBegin(u); k < g.inEnd(u); k++)
+                if (!seen[g.rSource[k]]) { seen[g.rSource[k]] = 1; order.push_back(g.rSource[k]); }
+        }
+    }
+    return order;
+}
+
+vector<uint32_t> rankOrder(Span<uint32_t> rank) {
+    vector<uint32_t> order(rank.size());
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&rank](uint32_t a, uint32_t b) { return rank[a] > rank[b]; });
+    return order;
+}
+
+vector<uint32_t> nodeOrder(const Graph& g, NodeOrder order) {
+    switch (order) {
+    case ORDER_HILBERT: return hilbertOrder(g);
+    case ORDER_BFS: return bfsOrder(g);
+    default: break;
+    }
+    vector<uint32_t> id(g.numNodes());
+    iota(id.begin(), id.end(), 0);
+    return id;
+}
+
+/* =========================================================
+   permuteNodes : order[ ȣ] =  ȣ  ׷ 籸
+   ========================================================= */
+Graph permuteNodes(const Graph& g, const vector<uint32_t>& order) {
+    uint32_t n = g.numNodes(), m = g.numEdges();
+    vector<uint32_t> newId(n);
+    for (uint32_t i = 0; i < n; i++) newId[order[i]] = i;
+
+    Graph r;
+    vector<double> lat(n), lon(n);
+    vector<uint32_t> idOff(n + 1), input(n), sorted(n);
+    vector<char> idChars;
+    idChars.reserve(g.idChars.size());
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t u = order[i];
+        lat[i] = g.lat[u];
+        lon[i] = g.lon[u];
+        input[i] = g.inputNode(u);
+        idOff[i] = (uint32_t)idChars.size();
+        string_view id = g.id(u);
+        idChars.insert(idChars.end(), id.begin(), id.end());
+    }
+    idOff[n] = (uint32_t)idChars.size();
+    for (uint32_t i = 0; i < n; i++) sorted[i] = newId[g.idSorted[i]]; //  ڿ̶   
+
+    vector<uint32_t> off(n + 1, 0), target(m), roadId(m);
+    vector<double> length(m);
+    vector<uint64_t> wayId(m);
+    vector<uint8_t> highway(m), oneway(m);
+    uint32_t k = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t u = order[i];
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++, k++) {
+            target[k] = newId[g.target[e]];
+            length[k] = g.length[e];
+            roadId[k] = g.attr.roadId[e];
+            wayId[k] = g.attr.wayId[e];
+            highway[k] = g.attr.highway[e];
+            oneway[k] = g.attr.oneway[e];
+        }
+        off[i + 1] = k;
+    }
+
+    r.lat = move(lat);
+    r.lon = move(lon);
+    r.idOffset = move(idOff);
+    r.idChars = move(idChars);
+    r.idSorted = move(sorted);
+    r.inputId = move(input);
+    r.offset = move(off);
+    r.target = move(target);
+    r.length = move(length);
+    r.attr.roadId = move(roadId);
+    r.attr.wayId = move(wayId);
+    r.attr.highway = move(highway);
+    r.attr.oneway = move(oneway);
+    r.attr.roadOffset = g.attr.roadOffset; // θ ̺    (̸   )
+    r.attr.roadChars = g.attr.roadChars;
+    r.storage = g.storage;
+    r.buildReverse();
+    return r;
+}
+
+/* =========================================================
+   ¿ :  path  "a-b-c-d" ڿ
+   ========================================================= */
+void appendDash(string& out, const Graph& g, Span<uint32_t> p) {
+    for (size_t i = 0; i < p.size(); i++) {
+        out += g.id(p[i]);
+        if (i + 1 < p.size()) out += '-';
+    }
+}
+
+string toDash(const Graph& g, Span<uint32_t> p) {
+    size_t len = p.size();
+    for (uint32_t u : p) len += g.idOffset[u + 1] - g.idOffset[u];
+    string s;
+    s.reserve(len);
+    appendDash(s, g, p);
+    return s;
+}
+
+/* =========================================================
+      ( Ʈ  ü Ÿ)
+   ========================================================= */
+double pathLength(const Graph& g, const vector<uint32_t>& p) {
+    double sum = 0;
+    for (size_t i = 1; i < p.size(); i++) {
+        uint32_t e = g.findEdge(p[i - 1], p[i]);
+        if (e != INVALID_EDGE) sum += g.length[e];
+    }
+    return sum;
+}
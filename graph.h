@@ -0,0 +1,294 @@
+/*
+ graph.h :  Ʈũ  ׷ 
+  - GraphML  id(ڿ) ε  0..n-1  ε ȯ
+  -   CSR(offset + target/length  迭) 
+  -  ڿ id  (toDash)θ 
+  - ε   ȣ Hilbert  / BFS  ġ (̿ 尡 ޸𸮿 ̿)
+  - 迭 Array<T> :  ϰų,  (mmap)  ״ Ŵ
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pool.h"
+
+static constexpr uint32_t INVALID_NODE = 0xFFFFFFFFu;
+static constexpr uint32_t INVALID_EDGE = 0xFFFFFFFFu;
+static constexpr double EARTH_R = 6371000.0; //  ()
+
+/* =========================================================
+   Haversine Ÿ  (lat/lon  meter)
+   ========================================================= */
+double haversine(double lat1, double lon1, double lat2, double lon2);
+
+/* =========================================================
+   Equirectangular ٻ Ÿ (meter)
+   - ﰢԼ  浵  cos(lat)   
+   -  Ը( km) haversine  0.1% ̳ ġ
+   ========================================================= */
+double equirectangular(double lat1, double lon1, double lat2, double lon2);
+
+/* ================================
+   Array<T> : ׷ 迭 
+   -   :  std::vector (ε/ )
+   -   : ܺ ޸(mmap  ) б  Ŵ
+   ================================ */
+template <class T>
+class Array {
+public:
+    Array() = default;
+    Array(std::vector<T>&& v) : own_(std::move(v)) { sync(); }
+    Array(const Array& o) { *this = o; }
+    Array(Array&& o) noexcept { *this = std::move(o); }
+
+    Array& operator=(const Array& o) {
+        if (this == &o) return *this;
+        if (o.owning()) { own_ = o.own_; sync(); }
+        else { own_.clear(); ptr_ = o.ptr_; n_ = o.n_; }
+        return *this;
+    }
+    Array& operator=(Array&& o) noexcept {
+        bool owning = o.owning();
+        own_ = std::move(o.own_);
+        if (owning) sync();
+        else { ptr_ = o.ptr_; n_ = o.n_; }
+        o.ptr_ = nullptr;
+        o.n_ = 0;
+        return *this;
+    }
+    Array& operator=(std::vector<T>&& v) { own_ = std::move(v); sync(); return *this; }
+
+    // ܺ ޸  ( )
+    void view(const T* p, size_t n) { own_.clear(); ptr_ = const_cast<T*>(p); n_ = n; }
+
+    //     
+    void assign(size_t n, const T& v) { own_.assign(n, v); sync(); }
+    void resize(size_t n) { own_.resize(n); sync(); }
+
+    size_t size() const { return n_; }
+    bool empty() const { return n_ == 0; }
+    const T* data() const { return ptr_; }
+    T* begin() { return ptr_; }
+    T* end() { return ptr_ + n_; }
+    const T* begin() const { return ptr_; }
+    const T* end() const { return ptr_ + n_; }
+    T& operator[](size_t i) { return ptr_[i]; }
+    const T& operator[](size_t i) const { return ptr_[i]; }
+
+private:
+    bool owning() const { return ptr_ == own_.data() && n_ == own_.size(); }
+    void sync() { ptr_ = own_.data(); n_ = own_.size(); }
+
+    std::vector<T> own_;
+    T* ptr_ = nullptr;
+    size_t n_ = 0;
+};
+
+/* ================================
+   Span<T> : б  迭  (std::vector / Array  )
+   ================================ */
+template <class T>
+struct Span {
+    Span(const std::vector<T>& v) : p(v.data()), n(v.size()) {}
+    Span(const Array<T>& a) : p(a.data()), n(a.size()) {}
+    Span(const T* p, size_t n) : p(p), n(n) {}
+
+    const T& operator[](size_t i) const { return p[i]; }
+    size_t size() const { return n; }
+    const T* begin() const { return p; }
+    const T* end() const { return p + n; }
+
+    const T* p;
+    size_t n;
+};
+
+/* ================================
+   HighwayClass : OSM highway ± з (EdgeAttributes::highway)
+   ================================ */
+enum HighwayClass : uint8_t {
+    HW_UNKNOWN, HW_MOTORWAY, HW_TRUNK, HW_PRIMARY, HW_SECONDARY, HW_TERTIARY,
+    HW_UNCLASSIFIED, HW_RESIDENTIAL, HW_LIVING_STREET, HW_SERVICE, HW_OTHER,
+    HW_COUNT
+};
+
+// "primary", "primary_link", "['primary', 'secondary']"   з (̸ ù )
+HighwayClass highwayClass(std::string_view tag);
+const char* highwayName(uint8_t hw);
+
+/* ================================
+   EdgeAttributes : Ž  ʴ  Ӽ (cold side table)
+   -  ȣ , ( ȳ)  
+   - θ ߺ     ( ε ̸ ϳ, 0   ̸)
+   - wayId : OSM way id (osmid  ̸ ù ,  0)
+   ================================ */
+struct EdgeAttributes {
+    Array<uint32_t> roadId;   // ũ m
+    Array<uint64_t> wayId;    // ũ m
+    Array<uint8_t> highway;   // ũ m (HighwayClass)
+    Array<uint8_t> oneway;    // ũ m (1 = Ϲ )
+
+    // θ ̺ : roadChars[roadOffset[r] .. roadOffset[r+1])
+    Array<uint32_t> roadOffset;
+    Array<char> roadChars;
+
+    uint32_t numRoads() const { return roadOffset.empty() ? 0 : (uint32_t)roadOffset.size() - 1; }
+    std::string_view road(uint32_t r) const {
+        return std::string_view(roadChars.data() + roadOffset[r], roadOffset[r + 1] - roadOffset[r]);
+    }
+    std::string_view roadName(uint32_t e) const { return road(roadId[e]); }
+};
+
+/* ================================
+   Graph : CSR   ׷
+   -  u    : [offset[u], offset[u+1])
+   - Ž 迭 target[e] / length[e] ,   Ӽ attr (EdgeAttributes)
+   -  CSR :  v    [rOffset[v], rOffset[v+1])
+     rSource[k] =  , rEdge[k] =   ȣ (  )
+   ================================ */
+struct Graph {
+    //   (ε =   ȣ)
+    Array<double> lat;
+    Array<double> lon;
+
+    // ڿ id ̺ : idChars[idOffset[u] .. idOffset[u+1])
+    Array<uint32_t> idOffset;
+    Array<char> idChars;
+    Array<uint32_t> idSorted; // id ڿ  ĵ  ȣ (find )
+
+    // CSR  迭
+    Array<uint32_t> offset;   // ũ n+1
+    Array<uint32_t> target;   // ũ m
+    Array<double> length;     // ũ m ()
+
+    //  Ӽ (θ, way id,  , Ϲ)
+    EdgeAttributes attr;
+
+    // (ġ) CSR : Ϲ  backward Ž
+    Array<uint32_t> rOffset;  // ũ n+1
+    Array<uint32_t> rSource;  // ũ m
+    Array<uint32_t> rEdge;    // ũ m
+
+    // ġ (ε )  ȣ : inputId[u] (ġ ʾ  )
+    Array<uint32_t> inputId;
+
+    //    ε   (迭   Ŵ)
+    std::shared_ptr<const void> storage;
+
+    uint32_t numNodes() const { return (uint32_t)lat.size(); }
+    uint32_t numEdges() const { return (uint32_t)target.size(); }
+
+    uint32_t edgeBegin(uint32_t u) const { return offset[u]; }
+    uint32_t edgeEnd(uint32_t u) const { return offset[u + 1]; }
+    uint32_t degree(uint32_t u) const { return offset[u + 1] - offset[u]; }
+    uint32_t inBegin(uint32_t v) const { return rOffset[v]; }
+    uint32_t inEnd(uint32_t v) const { return rOffset[v + 1]; }
+
+    std::string_view id(uint32_t u) const {
+        return std::string_view(idChars.data() + idOffset[u], idOffset[u + 1] - idOffset[u]);
+    }
+    std::string_view roadName(uint32_t e) const { return attr.roadName(e); }
+    uint32_t inputNode(uint32_t u) const { return inputId.empty() ? u : inputId[u]; }
+
+    // ڿ id   ȣ ( INVALID_NODE)
+    uint32_t find(std::string_view id) const;
+
+    // u  v    ª  ( INVALID_EDGE)
+    uint32_t findEdge(uint32_t u, uint32_t v) const;
+
+    // target/offset κ  CSR 籸
+    void buildReverse();
+};
+
+/* ================================
+   GraphBuilder : ε  /  CSR  ȯ
+   -  id / θ StringPool  intern (ڿ Ҵ )
+   - build()  Ǯ ۸ ׷ ̺ ѱ  ε ۵   
+   ================================ */
+class GraphBuilder {
+public:
+    //   (̹  ǥ )   ȣ
+    uint32_t addNode(std::string_view id, double lat, double lon);
+    // id   (ǥ ,    )
+    uint32_t intern(std::string_view id);
+    bool has(std::string_view id) const { return ids.find(id) != StringPool::NONE; }
+
+    // length  NaN ̸ build()     ǥ  ( 庸  ͵ )
+    void addEdge(uint32_t s, uint32_t t, double length, std::string_view road, bool oneway = false,
+                 uint64_t wayId = 0, uint8_t highway = HW_UNKNOWN);
+
+    double lat(uint32_t u) const { return nodeLat[u]; }
+    double lon(uint32_t u) const { return nodeLon[u]; }
+
+    Graph build();
+
+private:
+    struct RawEdge {
+        uint32_t s, t;
+        double length;
+        uint64_t wayId;
+        uint32_t road;
+        uint8_t highway;
+        bool oneway;
+    };
+
+    StringPool ids;
+    StringPool roads;
+    std::vector<double> nodeLat, nodeLon;
+    std::vector<uint8_t> declared; // <node>  ǥ ־ 
+    std::vector<RawEdge> edges;
+};
+
+/* ================================
+    ȣ ġ 
+   - ORDER_INPUT   : GraphML   ״
+   - ORDER_HILBERT : ǥ Hilbert   (    ȣ)
+   - ORDER_BFS     : Hilbert  ù  ʺ 켱 ( Ҹ)
+   ================================ */
+enum NodeOrder : uint8_t { ORDER_INPUT, ORDER_HILBERT, ORDER_BFS };
+
+/* ================================
+   GraphML ε ɼ
+   - useLengthAttr : length Ӽ  (false  ǥ haversine )
+   - honourOneway  : oneway=true   ⸸ ߰
+   - order         : ε   ȣ ġ 
+   ================================ */
+struct GraphMLOptions {
+    bool useLengthAttr = true;
+    bool honourOneway = true;
+    NodeOrder order = ORDER_HILBERT;
+};
+
+// Ʈ ε :      / ٷ GraphBuilder   (DOM Ʈ )
+bool loadGraphML(const std::string& file, Graph& g, const GraphMLOptions& opt = GraphMLOptions());
+
+// tinyxml2 DOM  ε ( ,  񱳿)
+bool loadGraphMLDom(const std::string& file, Graph& g, const GraphMLOptions& opt = GraphMLOptions());
+
+/* =========================================================
+    ġ
+   -  迭 order[ ȣ] =  ȣ
+   - permuteNodes :  迭/id ̺/CSR/ Ӽ  ȣ ٽ 
+     (庰    , inputId  ε  ȣ ̾ )
+   - rankOrder    :  (CH rank)  (upward Ž  带 ʿ )
+   ========================================================= */
+std::vector<uint32_t> hilbertOrder(const Graph& g);
+std::vector<uint32_t> bfsOrder(const Graph& g);
+std::vector<uint32_t> rankOrder(Span<uint32_t> rank);
+std::vector<uint32_t> nodeOrder(const Graph& g, NodeOrder order);
+Graph permuteNodes(const Graph& g, const std::vector<uint32_t>& order);
+
+/* =========================================================
+   ¿ :  ȣ path  "a-b-c-d" ڿ ( GraphML id )
+   - δ ȣθ  ٴϴٰ     ڿ 
+   - appendDash : ȣ ڿ ۿ ̾  (۸ ϸ Ҵ )
+   ========================================================= */
+std::string toDash(const Graph& g, Span<uint32_t> p);
+void appendDash(std::string& out, const Graph& g, Span<uint32_t> p);
+
+//    ()
+double pathLength(const Graph& g, const std::vector<uint32_t>& p);
@@ -0,0 +1,63 @@
+/*
+ graphml2bin.cpp : GraphML  ̳ʸ  ȯ 
+   : graphml2bin <Է.graphml> [.bin] [--haversine] [--twoway] [--order hilbert|bfs|input]
+   --haversine : length Ӽ  ǥ  Ÿ  (project1   )
+   --twoway    : oneway ,   
+   --order     :  ȣ ġ  (⺻ hilbert, input  GraphML  )
+   θ ϸ loadGraph()  ã ̸(snapshotPath) 
+*/
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "snapshot.h"
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    GraphMLOptions opt;
+    vector<string> files;
+    for (int i = 1; i < argc; i++) {
+        string a = argv[i];
+        if (a == "--haversine") opt.useLengthAttr = false;
+        else if (a == "--twoway") opt.honourOneway = false;
+        else if (a == "--order" && i + 1 < argc) {
+            string o = argv[++i];
+            if (o == "input") opt.order = ORDER_INPUT;
+            else if (o == "bfs") opt.order = ORDER_BFS;
+            else opt.order = ORDER_HILBERT;
+        }
+        else files.push_back(a);
+    }
+    if (files.empty() || files.size() > 2) {
+        cerr << " : graphml2bin <Է.graphml> [.bin] [--haversine] [--twoway] [--order hilbert|bfs|input]\n";
+        return 1;
+    }
+    string out = files.size() == 2 ? files[1] : snapshotPath(files[0], opt);
+
+    auto t0 = chrono::steady_clock::now();
+    Graph g;
+    if (!loadGraphML(files[0], g, opt)) {
+        cerr << "GraphML ε  : " << files[0] << "\n";
+        return 1;
+    }
+    auto t1 = chrono::steady_clock::now();
+    if (!writeSnapshot(g, out, opt, sourceStamp(files[0]))) {
+        cerr << "   : " << out << "\n";
+        return 1;
+    }
+    auto t2 = chrono::steady_clock::now();
+
+    Graph m;
+    if (!mapSnapshot(out, m, &opt)) {
+        cerr << "   : " << out << "\n";
+        return 1;
+    }
+    auto t3 = chrono::steady_clock::now();
+
+    auto ms = [](auto a, auto b) { return chrono::duration<double, milli>(b - a).count(); };
+    cout << " " << g.numNodes() << ",  " << g.numEdges() << "  " << out << "\n";
+    cout << "GraphML Ľ " << ms(t0, t1) << " ms,  " << ms(t1, t2) << " ms, mmap " << ms(t2, t3) << " ms\n";
+    return 0;
+}
@@ -0,0 +1,288 @@
+/*
+ heap.h : Dijkstra Ž 켱 ť å
+  - BinaryHeap      :  priority_queue  (ߺ ,   stale ǳʶ)
+  - IndexedDaryHeap : 庰 ġ ϴ d-ary , ¥ decrease-key (ߺ )
+  - RadixHeap       :  ȭ  (monotone) radix ť
+  - RadixHeap32     : ó uint32  Ҽ  radix ť (ȭ  ,  8 Ʈ)
+
+  ̽
+  - resize(n) / clear() / empty() / size()
+  - push(u, key) :  Ǵ key 
+  - top()        : (key, u) ּ  
+  - pop()        : (key, u) ּ  
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/* ================================
+   BinaryHeap : std::push_heap / pop_heap  (lazy insertion)
+   ================================ */
+class BinaryHeap {
+public:
+    void resize(uint32_t) {}
+    void clear() { heap_.clear(); }
+    bool empty() const { return heap_.empty(); }
+    size_t size() const { return heap_.size(); }
+
+    void push(uint32_t u, double key) {
+        heap_.push_back({ key, u });
+        std::push_heap(heap_.begin(), heap_.end(), std::greater<>());
+    }
+
+    std::pair<double, uint32_t> top() const { return heap_.front(); }
+
+    std::pair<double, uint32_t> pop() {
+        std::pop_heap(heap_.begin(), heap_.end(), std::greater<>());
+        auto top = heap_.back();
+        heap_.pop_back();
+        return top;
+    }
+
+private:
+    std::vector<std::pair<double, uint32_t>> heap_;
+};
+
+/* ================================
+   IndexedDaryHeap : D   +  ġ 
+   - pos_[u] :  迭  ġ ( NONE)
+   - clear()    Ҹ   O( )
+   ================================ */
+template <unsigned D = 4>
+class IndexedDaryHeap {
+public:
+    void resize(uint32_t n) {
+        pos_.assign(n, NONE);
+        heap_.clear();
+    }
+    void clear() {
+        for (auto& it : heap_) pos_[it.node] = NONE;
+        heap_.clear();
+    }
+    bool empty() const { return heap_.empty(); }
+    size_t size() const { return heap_.size(); }
+    bool contains(uint32_t u) const { return pos_[u] != NONE; }
+
+    void push(uint32_t u, double key) {
+        uint32_t i = pos_[u];
+        if (i == NONE) {
+            i = (uint32_t)heap_.size();
+            heap_.push_back({ key, u });
+        } else {
+            if (key >= heap_[i].key) return;
+            heap_[i].key = key;
+        }
+        siftUp(i);
+    }
+
+    std::pair<double, uint32_t> top() const { return { heap_[0].key, heap_[0].node }; }
+
+    std::pair<double, uint32_t> pop() {
+        Item top = heap_[0];
+        pos_[top.node] = NONE;
+        Item last = heap_.back();
+        heap_.pop_back();
+        if (!heap_.empty()) {
+            heap_[0] = last;
+            pos_[last.node] = 0;
+            siftDown(0);
+        }
+        return { top.key, top.node };
+    }
+
+private:
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+    struct Item {
+        double key;
+        uint32_t node;
+    };
+
+    void siftUp(uint32_t i) {
+        Item it = heap_[i];
+        while (i > 0) {
+            uint32_t p = (i - 1) / D;
+            if (heap_[p].key <= it.key) break;
+            heap_[i] = heap_[p];
+            pos_[heap_[i].node] = i;
+            i = p;
+        }
+        heap_[i] = it;
+        pos_[it.node] = i;
+    }
+
+    void siftDown(uint32_t i) {
+        Item it = heap_[i];
+        uint32_t n = (uint32_t)heap_.size();
+        for (;;) {
+            uint32_t c = i * D + 1;
+            if (c >= n) break;
+            uint32_t end = std::min(c + D, n);
+            uint32_t best = c;
+            for (uint32_t k = c + 1; k < end; k++)
+                if (heap_[k].key < heap_[best].key) best = k;
+            if (heap_[best].key >= it.key) break;
+            heap_[i] = heap_[best];
+            pos_[heap_[i].node] = i;
+            i = best;
+        }
+        heap_[i] = it;
+        pos_[it.node] = i;
+    }
+
+    std::vector<Item> heap_;
+    std::vector<uint32_t> pos_;
+};
+
+using QuadHeap = IndexedDaryHeap<4>;
+
+/* ================================
+   RadixHeap :   Ű radix ť
+   - key  scale  ؼ  ȭ (⺻ 1/1000 )
+   -  ּҰ  key     (Dijkstra  ׻ )
+   -          1/scale 
+   ================================ */
+class RadixHeap {
+public:
+    explicit RadixHeap(double scale = 1000.0) : scale_(scale) {}
+
+    void setScale(double scale) { scale_ = scale; }
+    void resize(uint32_t) { clear(); }
+    void clear() {
+        for (auto& b : buckets_) b.clear();
+        size_ = 0;
+        last_ = 0;
+    }
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+
+    void push(uint32_t u, double key) {
+        uint64_t q = quantise(key);
+        if (q < last_) q = last_;
+        buckets_[bucketOf(q)].push_back({ q, key, u });
+        size_++;
+    }
+
+    std::pair<double, uint32_t> top() {
+        refill();
+        const Item& it = buckets_[0].back();
+        return { it.key, it.node };
+    }
+
+    std::pair<double, uint32_t> pop() {
+        refill();
+        Item it = buckets_[0].back();
+        buckets_[0].pop_back();
+        size_--;
+        return { it.key, it.node };
+    }
+
+private:
+    struct Item {
+        uint64_t q;
+        double key;
+        uint32_t node;
+    };
+
+    // 0  Ŷ   Ŷ ּ Ű  й
+    void refill() {
+        if (buckets_[0].empty()) {
+            unsigned i = 1;
+            while (buckets_[i].empty()) i++;
+
+            //   Ű     Ŷ й
+            uint64_t mn = buckets_[i][0].q;
+            for (auto& it : buckets_[i]) mn = std::min(mn, it.q);
+            last_ = mn;
+            for (auto& it : buckets_[i]) buckets_[bucketOf(it.q)].push_back(it);
+            buckets_[i].clear();
+        }
+    }
+
+    uint64_t quantise(double key) const { return key > 0 ? (uint64_t)(key * scale_) : 0; }
+
+    unsigned bucketOf(uint64_t q) const {
+        uint64_t x = q ^ last_;
+        unsigned b = 0;
+        while (x) { x >>= 1; b++; }
+        return b;
+    }
+
+    double scale_;
+    std::vector<Item> buckets_[65];
+    size_t size_ = 0;
+    uint64_t last_ = 0;
+};
+
+/* ================================
+   RadixHeap32 : uint32 Ű  radix ť (compact.h  Ҽ )
+   - Ű ̹  ȭ  Ȯ, Ŷ 33 
+   -  ּҰ  key     (Dijkstra  ׻ )
+   ================================ */
+class RadixHeap32 {
+public:
+    void resize(uint32_t) { clear(); }
+    void clear() {
+        for (auto& b : buckets_) b.clear();
+        size_ = 0;
+        last_ = 0;
+    }
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+
+    void push(uint32_t u, uint32_t key) {
+        buckets_[bucketOf(key)].push_back({ key, u });
+        size_++;
+    }
+
+    std::pair<uint32_t, uint32_t> top() {
+        refill();
+        const Item& it = buckets_[0].back();
+        return { it.key, it.node };
+    }
+
+    std::pair<uint32_t, uint32_t> pop() {
+        refill();
+        Item it = buckets_[0].back();
+        buckets_[0].pop_back();
+        size_--;
+        return { it.key, it.node };
+    }
+
+private:
+    struct Item {
+        uint32_t key;
+        uint32_t node;
+    };
+
+    void refill() {
+        if (buckets_[0].empty()) {
+            unsigned i = 1;
+            while (buckets_[i].empty()) i++;
+            uint32_t mn = buckets_[i][0].key;
+            for (auto& it : buckets_[i]) mn = std::min(mn, it.key);
+            last_ = mn;
+            for (auto& it : buckets_[i]) buckets_[bucketOf(it.key)].push_back(it);
+            buckets_[i].clear();
+        }
+    }
+
+    // ֻ ٸ Ʈ ġ + 1 ( 0)
+    unsigned bucketOf(uint32_t key) const {
+        uint32_t x = key ^ last_;
+#if defined(__GNUC__)
+        return x ? 32 - (unsigned)__builtin_clz(x) : 0;
+#else
+        unsigned b = 0;
+        while (x) { x >>= 1; b++; }
+        return b;
+#endif
+    }
+
+    std::vector<Item> buckets_[33];
+    size_t size_ = 0;
+    uint32_t last_ = 0;
+};
@@ -0,0 +1,199 @@
+#include "isochrone.h"
+
+#include <algorithm>
+
+#include "parallel.h"
+
+using namespace std;
+
+/* =========================================================
+     Dijkstra
+   -   budget    (     )
+   -   : Ȯ  u    d(u) + w > budget  
+   ========================================================= */
+void reachable(const Graph& g, SearchWorkspace& ws, uint32_t source, double budget, Span<double> weight,
+               Isochrone& out) {
+    out.budget = budget;
+    out.nodes.clear();
+    out.dist.clear();
+    out.boundary.clear();
+    if (ws.size() != g.numNodes()) ws.resize(g.numNodes());
+    ws.reset();
+
+    auto& pq = ws.queue;
+    ws.set(source, 0, INVALID_NODE);
+    pq.push(source, 0);
+    while (!pq.empty()) {
+        auto [cd, u] = pq.pop();
+        if (cd > ws.dist(u)) continue; // stale
+        if (cd > budget) break;
+        out.nodes.push_back(u);
+        out.dist.push_back(cd);
+
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+            double nd = cd + weight[e];
+            if (nd > budget) {
+                out.boundary.push_back({ e, u, weight[e] > 0 ? (budget - cd) / weight[e] : 1.0 });
+                continue;
+            }
+            uint32_t v = g.target[e];
+            if (ws.dist(v) > nd) {
+                ws.set(v, nd, u);
+                pq.push(v, nd);
+            }
+        }
+    }
+}
+
+void isochroneFromDistances(const Graph& g, Span<double> dist, double budget, Span<double> weight, Isochrone& out) {
+    out.budget = budget;
+    out.nodes.clear();
+    out.dist.clear();
+    out.boundary.clear();
+    for (uint32_t u = 0; u < g.numNodes(); u++)
+        if (dist[u] <= budget) out.nodes.push_back(u);
+    sort(out.nodes.begin(), out.nodes.end(), [&](uint32_t a, uint32_t b) {
+        return dist[a] != dist[b] ? dist[a] < dist[b] : a < b;
+    });
+    for (uint32_t u : out.nodes) {
+        out.dist.push_back(dist[u]);
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+            if (dist[u] + weight[e] > budget)
+                out.boundary.push_back({ e, u, weight[e] > 0 ? (budget - dist[u]) / weight[e] : 1.0 });
+        }
+    }
+}
+
+/* =========================================================
+     (Andrew monotone chain, 浵 = x,  = y)
+   -  ȯ Һ̹Ƿ 浵 ״ 
+   ========================================================= */
+vector<GeoPoint> isochronePolygon(const Graph& g, const Isochrone& iso) {
+    vector<GeoPoint> pts;
+    pts.reserve(iso.nodes.size() + iso.boundary.size());
+    for (uint32_t u : iso.nodes) pts.push_back({ g.lat[u], g.lon[u] });
+    for (auto& b : iso.boundary) {
+        uint32_t v = g.target[b.edge];
+        pts.push_back({ g.lat[b.source] + (g.lat[v] - g.lat[b.source]) * b.fraction,
+                        g.lon[b.source] + (g.lon[v] - g.lon[b.source]) * b.fraction });
+    }
+    sort(pts.begin(), pts.end(), [](const GeoPoint& a, const GeoPoint& b) {
+        return a.lon != b.lon ? a.lon < b.lon : a.lat < b.lat;
+    });
+    pts.erase(unique(pts.begin(), pts.end(), [](const GeoPoint& a, const GeoPoint& b) {
+        return a.lon == b.lon && a.lat == b.lat;
+    }), pts.end());
+    if (pts.size() < 3) return pts;
+
+    auto cross = [](const GeoPoint& o, const GeoPoint& a, const GeoPoint& b) {
+        return (a.lon - o.lon) * (b.lat - o.lat) - (a.lat - o.lat) * (b.lon - o.lon);
+    };
+    vector<GeoPoint> hull(2 * pts.size());
+    size_t k = 0;
+    for (size_t i = 0; i < pts.size(); i++) {
+        while (k >= 2 && cross(hull[k - 2], hull[k - 1], pts[i]) <= 0) k--;
+        hull[k++] = pts[i];
+    }
+    for (size_t i = pts.size() - 1, t = k + 1; i-- > 0;) {
+        while (k >= t && cross(hull[k - 2], hull[k - 1], pts[i]) <= 0) k--;
+        hull[k++] = pts[i];
+    }
+    hull.resize(k - 1);
+    return hull;
+}
+
+/* =========================================================
+   PHAST غ :    ġ,  arc   ġ  CSR 
+   - CHGraph::bw  ̹ "v     x  v"   ȣ ġ ٲ
+   ========================================================= */
+Phast::Phast(const CHGraph& ch) : ch_(ch) {
+    uint32_t n = ch.numNodes();
+    order_.resize(n);
+    for (uint32_t u = 0; u < n; u++) order_[u] = u;
+    sort(order_.begin(), order_.end(), [&](uint32_t a, uint32_t b) { return ch.rank[a] > ch.rank[b]; });
+    pos_.resize(n);
+    for (uint32_t i = 0; i < n; i++) pos_[order_[i]] = i;
+
+    inOffset_.assign(n + 1, 0);
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t v = order_[i];
+        inOffset_[i + 1] = inOffset_[i] + (ch.bwOffset[v + 1] - ch.bwOffset[v]);
+    }
+    inSource_.resize(inOffset_[n]);
+    inWeight_.resize(inOffset_[n]);
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t v = order_[i], k = inOffset_[i];
+        for (uint32_t a = ch.bwOffset[v]; a < ch.bwOffset[v + 1]; a++, k++) {
+            inSource_[k] = pos_[ch.bwTarget[a]];
+            inWeight_[k] = ch.bwWeight[a];
+        }
+    }
+}
+
+/* =========================================================
+   PHAST sweep ( count  LANES )
+   1)  upward Dijkstra  lane[ġ * LANES + l] ʱⰪ
+   2) ġ 0 (  )  ʷ  arc ȭ : д ġ ׻ ̹ Ȯ
+   ========================================================= */
+void Phast::sweep(const uint32_t* sources, unsigned count, SearchWorkspace& up, vector<double>& lane) const {
+    uint32_t n = ch_.numNodes();
+    lane.assign((size_t)n * LANES, INF_DIST);
+    if (up.size() != n) up.resize(n);
+
+    for (unsigned l = 0; l < count; l++) {
+        up.reset();
+        up.set(sources[l], 0, INVALID_NODE);
+        up.queue.push(sources[l], 0);
+        while (!up.queue.empty()) {
+            auto [d, u] = up.queue.pop();
+            if (d > up.dist(u)) continue;
+            lane[(size_t)pos_[u] * LANES + l] = d;
+            for (uint32_t k = ch_.upOffset[u]; k < ch_.upOffset[u + 1]; k++) {
+                uint32_t v = ch_.upTarget[k];
+                double nd = d + ch_.upWeight[k];
+                if (up.dist(v) > nd) {
+                    up.set(v, nd, u);
+                    up.queue.push(v, nd);
+                }
+            }
+        }
+    }
+
+    double* D = lane.data();
+    for (uint32_t i = 0; i < n; i++) {
+        double* di = D + (size_t)i * LANES;
+        for (uint32_t k = inOffset_[i]; k < inOffset_[i + 1]; k++) {
+            const double* dj = D + (size_t)inSource_[k] * LANES;
+            double w = inWeight_[k];
+            for (unsigned l = 0; l < LANES; l++) di[l] = min(di[l], dj[l] + w);
+        }
+    }
+}
+
+void Phast::oneToAll(uint32_t source, vector<double>& dist) const {
+    uint32_t n = ch_.numNodes();
+    SearchWorkspace up(n);
+    vector<double> lane;
+    sweep(&source, 1, up, lane);
+    dist.resize(n);
+    for (uint32_t i = 0; i < n; i++) dist[order_[i]] = lane[(size_t)i * LANES];
+}
+
+void Phast::manyToAll(const vector<uint32_t>& sources, vector<double>& out, unsigned threads) const {
+    uint32_t n = ch_.numNodes();
+    out.assign(sources.size() * n, INF_DIST);
+    if (threads == 0) threads = defaultThreads();
+    size_t groups = (sources.size() + LANES - 1) / LANES;
+    vector<SearchWorkspace> up(threads);
+    vector<vector<double>> lane(threads);
+
+    parallelFor(groups, threads, [&](unsigned tid, size_t gi) {
+        size_t first = gi * LANES;
+        unsigned count = (unsigned)min<size_t>(LANES, sources.size() - first);
+        sweep(sources.data() + first, count, up[tid], lane[tid]);
+        for (unsigned l = 0; l < count; l++) {
+            double* row = out.data() + (first + l) * n;
+            for (uint32_t i = 0; i < n; i++) row[order_[i]] = lane[tid][(size_t)i * LANES + l];
+        }
+    }, 1);
+}
@@ -0,0 +1,69 @@
+/*
+ isochrone.h :    (ð / Ÿ  ȿ   ִ )
+  - reachable() :  Ѵ   ߴ Dijkstra  Ȯ  +  
+  - isochroneFromDistances() : ̹  one-to-all Ÿ(PHAST )   
+  - isochronePolygon() : Ȯ      δ  ٰ
+  - Phast : CH  upward Ž   +    sweep  one-to-all
+            带 sweep  ġ ޸  ,  LANES   sweep  
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ch.h"
+#include "graph.h"
+#include "search.h"
+
+/* ================================
+   BoundaryEdge :  ȿ    ϴ 
+   - fraction : source       ִ  (0 ~ 1)
+   ================================ */
+struct BoundaryEdge {
+    uint32_t edge;
+    uint32_t source;
+    double fraction;
+};
+
+struct Isochrone {
+    double budget = 0;
+    std::vector<uint32_t> nodes;          // Ȯ  ( )
+    std::vector<double> dist;             // nodes[i]  
+    std::vector<BoundaryEdge> boundary;
+};
+
+struct GeoPoint {
+    double lat, lon;
+};
+
+// weight[e] :   (:  / AVG_SPEED)
+void reachable(const Graph& g, SearchWorkspace& ws, uint32_t source, double budget, Span<double> weight, Isochrone& out);
+
+// dist[u] : source  u  ( Ұ INF_DIST)
+void isochroneFromDistances(const Graph& g, Span<double> dist, double budget, Span<double> weight, Isochrone& out);
+
+// ݽð    ( 3  ̸̸ ״)
+std::vector<GeoPoint> isochronePolygon(const Graph& g, const Isochrone& iso);
+
+class Phast {
+public:
+    static constexpr unsigned LANES = 4;
+
+    explicit Phast(const CHGraph& ch);
+
+    // dist[u] : source  u  ( ȣ )
+    void oneToAll(uint32_t source, std::vector<double>& dist) const;
+
+    // out[i * n + u] : sources[i]  u, 帶 LANES   sweep
+    void manyToAll(const std::vector<uint32_t>& sources, std::vector<double>& out, unsigned threads = 0) const;
+
+private:
+    void sweep(const uint32_t* sources, unsigned count, SearchWorkspace& up, std::vector<double>& lane) const;
+
+    const CHGraph& ch_;
+    std::vector<uint32_t> order_;     // sweep ġ   ( )
+    std::vector<uint32_t> pos_;       //   sweep ġ
+    std::vector<uint32_t> inOffset_;  // ġ i   arc [inOffset_[i], inOffset_[i+1])
+    std::vector<uint32_t> inSource_;  //  ġ (׻ i  )
+    std::vector<double> inWeight_;
+};
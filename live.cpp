@@ -0,0 +1,102 @@
+#include "live.h"
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+
+using namespace std;
+
+LiveTraffic::LiveTraffic(const Graph& g, vector<double> base, const CCH* cch, unsigned threads)
+    : g_(g), base_(move(base)), cch_(cch), threads_(threads) {
+    auto s = make_shared<TrafficState>();
+    s->delay.reset(g);
+    s->weight = base_;
+    if (cch_) customize(*cch_, s->weight, s->metric, threads_);
+    state_ = move(s);
+}
+
+shared_ptr<const TrafficState> LiveTraffic::current() const {
+    return atomic_load(&state_);
+}
+
+/* =========================================================
+    
+   1)    (д     )
+   2)  ݿ + ٲ   (    )
+   3) ٲ   ü customize, ƴϸ  ޴ arc 
+   4)  ü 
+   ========================================================= */
+uint64_t LiveTraffic::apply(const vector<DelayUpdate>& batch) {
+    lock_guard<mutex> lock(writer_);
+    auto old = atomic_load(&state_);
+    if (batch.empty()) return old->version;
+
+    auto s = make_shared<TrafficState>(*old);
+    vector<uint32_t> changed;
+    for (const DelayUpdate& u : batch) {
+        if (u.to == INVALID_NODE) {
+            s->delay.setNode(u.from, u.delay);
+            for (uint32_t k = g_.inBegin(u.from); k < g_.inEnd(u.from); k++) changed.push_back(g_.rEdge[k]);
+        } else if (s->delay.setEdge(g_, u.from, u.to, u.delay)) {
+            for (uint32_t e = g_.edgeBegin(u.from); e < g_.edgeEnd(u.from); e++)
+                if (g_.target[e] == u.to) changed.push_back(e);
+        }
+    }
+    sort(changed.begin(), changed.end());
+    changed.erase(unique(changed.begin(), changed.end()), changed.end());
+    for (uint32_t e : changed) s->weight[e] = base_[e] + s->delay(g_, e);
+
+    if (cch_ && !changed.empty()) {
+        if (changed.size() * 8 > g_.numEdges()) customize(*cch_, s->weight, s->metric, threads_);
+        else customizeEdges(*cch_, g_, s->weight, changed, s->metric);
+    }
+    s->version = old->version + 1;
+    uint64_t v = s->version;
+    atomic_store(&state_, shared_ptr<const TrafficState>(move(s)));
+    return v;
+}
+
+bool LiveTraffic::parse(const string& line, DelayUpdate& u) const {
+    istringstream in(line);
+    string a, b, c;
+    if (!(in >> a >> b)) return false;
+    in >> c;
+    try {
+        u.from = g_.find(a);
+        if (c.empty()) {
+            u.to = INVALID_NODE;
+            u.delay = stod(b);
+        } else {
+            u.to = g_.find(b);
+            u.delay = stod(c);
+            if (u.to == INVALID_NODE) return false;
+        }
+    } catch (const exception&) {
+        return false;
+    }
+    return u.from != INVALID_NODE;
+}
+
+size_t LiveTraffic::consume(istream& in, size_t maxBatch, const function<void(const TrafficState&)>& onPublish) {
+    vector<DelayUpdate> batch;
+    size_t total = 0;
+    auto flush = [&]() {
+        if (batch.empty()) return;
+        apply(batch);
+        total += batch.size();
+        batch.clear();
+        if (onPublish) onPublish(*current());
+    };
+
+    string line;
+    while (getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.find_first_not_of(" \t") == string::npos) { flush(); continue; }
+        if (line[line.find_first_not_of(" \t")] == '#') continue;
+        DelayUpdate u;
+        if (parse(line, u)) batch.push_back(u);
+        if (batch.size() >= maxBatch) flush();
+    }
+    flush();
+    return total;
+}
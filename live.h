@@ -0,0 +1,71 @@
+/*
+ live.h : ǽð ȣ   ä
+  -   : current()  Һ (TrafficState)   θ Ž   , ߿  ٲ 
+  -   : apply()   ¸  и ݿϰ    ü (RCU)
+                    װ  ǰ   shared_ptr  
+  - CCH   ٲ   arc  ٽ customize (customizeEdges)
+  - consume() :  /  tail / ǥ Է  istream    о   
+      "from to delay"  :  from  to  ()
+      "node delay"     :   ()
+        Ǵ maxBatch ٸ   ݿ, '#'  ϴ  
+*/
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cch.h"
+#include "delay.h"
+#include "graph.h"
+
+/* ================================
+   DelayUpdate :    
+   - to == INVALID_NODE ̸ (from) 
+   ================================ */
+struct DelayUpdate {
+    uint32_t from, to;
+    double delay;
+};
+
+/* ================================
+   TrafficState :     (   )
+   ================================ */
+struct TrafficState {
+    uint64_t version = 0;
+    DelayTable delay;
+    std::vector<double> weight; //   = ⺻  + 
+    CCHMetric metric;           // CCH   쿡 ä
+
+    double operator()(uint32_t, uint32_t e) const { return weight[e]; }
+};
+
+class LiveTraffic {
+public:
+    // base[e] :    , cch   ó   ü customize
+    LiveTraffic(const Graph& g, std::vector<double> base, const CCH* cch = nullptr, unsigned threads = 0);
+
+    std::shared_ptr<const TrafficState> current() const;
+
+    //         version
+    uint64_t apply(const std::vector<DelayUpdate>& batch);
+
+    // in    б,   onPublish ȣ    
+    size_t consume(std::istream& in, size_t maxBatch = 256,
+                   const std::function<void(const TrafficState&)>& onPublish = {});
+
+    //   ؼ (GraphML id ),  Ʋų   false
+    bool parse(const std::string& line, DelayUpdate& u) const;
+
+private:
+    const Graph& g_;
+    std::vector<double> base_;
+    const CCH* cch_;
+    unsigned threads_;
+    std::mutex writer_; // ų ȭ (Ǵ  )
+    std::shared_ptr<const TrafficState> state_;
+};
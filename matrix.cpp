@@ -0,0 +1,298 @@
+#include "matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#include "parallel.h"
+
+using namespace std;
+
+static const float FINF = INFINITY;
+
+/* =========================================================
+     :  ǥ  Dijkstra,   0  Ǹ 
+   ========================================================= */
+void oneToMany(const Graph& g, SearchWorkspace& ws, Span<double> weight, uint32_t source,
+               const vector<uint32_t>& targets, float* row) {
+    if (ws.size() != g.numNodes()) ws.resize(g.numNodes());
+    ws.reset();
+
+    //     Ȯ    (ߺ  )
+    vector<uint32_t> want(targets);
+    sort(want.begin(), want.end());
+    want.erase(unique(want.begin(), want.end()), want.end());
+    size_t left = want.size();
+
+    auto& pq = ws.queue;
+    ws.set(source, 0, INVALID_NODE);
+    pq.push(source, 0);
+    while (!pq.empty() && left > 0) {
+        auto [cd, u] = pq.pop();
+        if (cd > ws.dist(u)) continue;
+        if (binary_search(want.begin(), want.end(), u)) left--;
+
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+            uint32_t v = g.target[e];
+            double nd = cd + weight[e];
+            if (ws.dist(v) > nd) {
+                ws.set(v, nd, u);
+                pq.push(v, nd);
+            }
+        }
+    }
+    for (size_t j = 0; j < targets.size(); j++) {
+        double d = ws.dist(targets[j]);
+        row[j] = d >= INF_DIST ? FINF : (float)d;
+    }
+}
+
+/* =========================================================
+   8 ĭ interleaved multi-source Dijkstra
+   - dist[u * 8 + l] :  l  u 
+   - ť Ű = ̹ پ ĭ ּҰ    8 ĭ  ȭ (label-correcting)
+   - ť ּ Ű   ĭ ִ ̸̻  پ ĭ Ƿ 
+   ========================================================= */
+namespace {
+
+constexpr unsigned LANES = 8;
+
+struct LaneWorkspace {
+    vector<float> dist;
+    vector<uint32_t> stamp;
+    uint32_t gen = 0;
+    QuadHeap queue;
+
+    void reset(uint32_t n) {
+        if (stamp.size() != n) {
+            dist.assign((size_t)n * LANES, FINF);
+            stamp.assign(n, 0);
+            queue.resize(n);
+            gen = 0;
+        }
+        queue.clear();
+        if (++gen == 0) {
+            fill(stamp.begin(), stamp.end(), 0);
+            gen = 1;
+        }
+    }
+
+    float* lanes(uint32_t u) {
+        float* d = &dist[(size_t)u * LANES];
+        if (stamp[u] != gen) {
+            stamp[u] = gen;
+            fill(d, d + LANES, FINF);
+        }
+        return d;
+    }
+};
+
+// dv = min(dv, du + w), پ ĭ   ĭ ּҰ ȯ ( INFINITY)
+inline float relaxLanes(const float* du, float w, float* dv) {
+#if defined(__SSE2__) || defined(_M_X64)
+    __m128 ww = _mm_set1_ps(w);
+    __m128 a0 = _mm_add_ps(_mm_loadu_ps(du), ww), a1 = _mm_add_ps(_mm_loadu_ps(du + 4), ww);
+    __m128 b0 = _mm_loadu_ps(dv), b1 = _mm_loadu_ps(dv + 4);
+    __m128 lt0 = _mm_cmplt_ps(a0, b0), lt1 = _mm_cmplt_ps(a1, b1);
+    if ((_mm_movemask_ps(lt0) | _mm_movemask_ps(lt1)) == 0) return FINF;
+    _mm_storeu_ps(dv, _mm_min_ps(a0, b0));
+    _mm_storeu_ps(dv + 4, _mm_min_ps(a1, b1));
+    // پ ĭ   INFINITY  ä ּҰ 
+    __m128 inf = _mm_set1_ps(FINF);
+    __m128 c0 = _mm_or_ps(_mm_and_ps(lt0, a0), _mm_andnot_ps(lt0, inf));
+    __m128 c1 = _mm_or_ps(_mm_and_ps(lt1, a1), _mm_andnot_ps(lt1, inf));
+    __m128 m = _mm_min_ps(c0, c1);
+    m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(m);
+#else
+    float key = FINF;
+    for (unsigned l = 0; l < LANES; l++) {
+        float nd = du[l] + w;
+        if (nd < dv[l]) {
+            dv[l] = nd;
+            key = min(key, nd);
+        }
+    }
+    return key;
+#endif
+}
+
+// src[l] = sources[rowOf[l]],  out  rowOf[l] 
+void laneSearch(const Graph& g, LaneWorkspace& ws, Span<double> weight, const vector<uint32_t>& sources,
+                const uint32_t* rowOf, unsigned count, const vector<uint32_t>& targets, CostMatrix& out) {
+    ws.reset(g.numNodes());
+    for (unsigned l = 0; l < count; l++) {
+        uint32_t s = sources[rowOf[l]];
+        ws.lanes(s)[l] = 0;
+        ws.queue.push(s, 0);
+    }
+
+    //  ĭ ִ : Ű     (   ĭ  256   ) ٽ 
+    auto targetBound = [&]() {
+        float b = 0;
+        for (uint32_t t : targets) {
+            const float* d = ws.lanes(t);
+            for (unsigned l = 0; l < count; l++) b = max(b, d[l]);
+        }
+        return b;
+    };
+    float bound = -1;
+    uint32_t pops = 0;
+
+    while (!ws.queue.empty()) {
+        auto [key, u] = ws.queue.pop();
+        if (key >= bound || (bound == FINF && (++pops & 255) == 0)) {
+            bound = targetBound();
+            if (key >= bound) break;
+        }
+        float du[LANES];
+        copy_n(ws.lanes(u), LANES, du);
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+            uint32_t v = g.target[e];
+            float k = relaxLanes(du, (float)weight[e], ws.lanes(v));
+            if (k < FINF) ws.queue.push(v, k);
+        }
+    }
+
+    for (unsigned l = 0; l < count; l++) {
+        float* row = &out.data[(size_t)rowOf[l] * out.cols];
+        for (size_t j = 0; j < targets.size(); j++) row[j] = ws.lanes(targets[j])[l];
+    }
+}
+
+// 浵 16 Ʈ ȭ Z-order Ű :     ǵ
+uint32_t mortonKey(double lat, double lon) {
+    auto q = [](double v, double lo, double span) {
+        double t = (v - lo) / span;
+        return (uint32_t)min(65535.0, max(0.0, t * 65535.0));
+    };
+    uint32_t x = q(lon, -180.0, 360.0), y = q(lat, -90.0, 180.0), key = 0;
+    for (int b = 15; b >= 0; b--) key = (key << 2) | (((y >> b) & 1) << 1) | ((x >> b) & 1);
+    return key;
+}
+
+} // namespace
+
+void dijkstraMatrix(const Graph& g, Span<double> weight, const vector<uint32_t>& sources,
+                    const vector<uint32_t>& targets, CostMatrix& out, unsigned threads) {
+    out.rows = (uint32_t)sources.size();
+    out.cols = (uint32_t)targets.size();
+    out.data.assign((size_t)out.rows * out.cols, FINF);
+    if (out.rows == 0 || out.cols == 0) return;
+
+    //  Ž      带 Բ Ȯ  ٽ  Ƚ پ
+    vector<uint32_t> order(sources.size());
+    for (uint32_t i = 0; i < order.size(); i++) order[i] = i;
+    vector<uint32_t> key(sources.size());
+    for (size_t i = 0; i < sources.size(); i++) key[i] = mortonKey(g.lat[sources[i]], g.lon[sources[i]]);
+    stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return key[a] < key[b]; });
+
+    if (threads == 0) threads = defaultThreads();
+    size_t batches = (sources.size() + LANES - 1) / LANES;
+    vector<LaneWorkspace> ws(threads);
+    parallelFor(batches, threads, [&](unsigned tid, size_t b) {
+        size_t first = b * LANES;
+        unsigned count = (unsigned)min<size_t>(LANES, sources.size() - first);
+        laneSearch(g, ws[tid], weight, sources, &order[first], count, targets, out);
+    }, 1);
+}
+
+/* =========================================================
+   CH bucket many-to-many
+   ========================================================= */
+namespace {
+
+struct BucketEntry {
+    uint32_t node;
+    uint32_t target; //  ȣ ()
+    double dist;
+};
+
+// upward Ž (stall-on-demand), Ȯ (, Ÿ)  visit ȣ
+template <class Visit>
+void upwardSearch(const vector<uint32_t>& off, const vector<uint32_t>& tgt, const vector<double>& wt,
+                  const vector<uint32_t>& soff, const vector<uint32_t>& stgt, const vector<double>& swt,
+                  SearchWorkspace& W, uint32_t start, Visit&& visit) {
+    W.reset();
+    W.set(start, 0, INVALID_NODE);
+    W.queue.push(start, 0);
+    while (!W.queue.empty()) {
+        auto [d, u] = W.queue.pop();
+        if (d > W.dist(u)) continue;
+
+        bool stalled = false;
+        for (uint32_t k = soff[u]; k < soff[u + 1] && !stalled; k++) stalled = W.dist(stgt[k]) + swt[k] < d;
+        if (stalled) continue;
+
+        visit(u, d);
+        for (uint32_t k = off[u]; k < off[u + 1]; k++) {
+            uint32_t v = tgt[k];
+            double nd = d + wt[k];
+            if (W.dist(v) > nd) {
+                W.set(v, nd, u);
+                W.queue.push(v, nd);
+            }
+        }
+    }
+}
+
+} // namespace
+
+void chMatrix(const CHGraph& ch, const vector<uint32_t>& sources, const vector<uint32_t>& targets,
+              CostMatrix& out, unsigned threads) {
+    out.rows = (uint32_t)sources.size();
+    out.cols = (uint32_t)targets.size();
+    out.data.assign((size_t)out.rows * out.cols, FINF);
+    if (out.rows == 0 || out.cols == 0) return;
+
+    uint32_t n = ch.numNodes();
+    if (threads == 0) threads = defaultThreads();
+    vector<SearchWorkspace> ws(threads);
+    for (auto& w : ws) w.resize(n);
+
+    // 1)  backward Ž  庰     CSR bucket
+    vector<vector<BucketEntry>> local(threads);
+    parallelFor(targets.size(), threads, [&](unsigned tid, size_t j) {
+        upwardSearch(ch.bwOffset, ch.bwTarget, ch.bwWeight, ch.upOffset, ch.upTarget, ch.upWeight, ws[tid], targets[j],
+                     [&](uint32_t u, double d) { local[tid].push_back({ u, (uint32_t)j, d }); });
+    }, 8);
+
+    vector<uint32_t> bucketOffset(n + 1, 0);
+    for (auto& l : local)
+        for (auto& b : l) bucketOffset[b.node + 1]++;
+    for (uint32_t u = 0; u < n; u++) bucketOffset[u + 1] += bucketOffset[u];
+    vector<uint32_t> bucketTarget(bucketOffset[n]);
+    vector<double> bucketDist(bucketOffset[n]);
+    {
+        vector<uint32_t> pos(bucketOffset.begin(), bucketOffset.end() - 1);
+        for (auto& l : local) {
+            for (auto& b : l) {
+                uint32_t k = pos[b.node]++;
+                bucketTarget[k] = b.target;
+                bucketDist[k] = b.dist;
+            }
+            vector<BucketEntry>().swap(l);
+        }
+    }
+
+    // 2)  forward Ž  bucket ȱ
+    parallelFor(sources.size(), threads, [&](unsigned tid, size_t i) {
+        float* row = &out.data[i * out.cols];
+        upwardSearch(ch.upOffset, ch.upTarget, ch.upWeight, ch.bwOffset, ch.bwTarget, ch.bwWeight, ws[tid], sources[i],
+                     [&](uint32_t u, double d) {
+                         for (uint32_t k = bucketOffset[u]; k < bucketOffset[u + 1]; k++) {
+                             float c = (float)(d + bucketDist[k]);
+                             if (c < row[bucketTarget[k]]) row[bucketTarget[k]] = c;
+                         }
+                     });
+    }, 8);
+}
+
+void costMatrix(const Graph& g, Span<double> weight, const CHGraph* ch, const vector<uint32_t>& sources,
+                const vector<uint32_t>& targets, CostMatrix& out, unsigned threads) {
+    if (ch) chMatrix(*ch, sources, targets, out, threads);
+    else dijkstraMatrix(g, weight, sources, targets, out, threads);
+}
@@ -0,0 +1,43 @@
+/*
+ matrix.h :      (  븸)
+  - oneToMany()      :  ϳ Dijkstra,   ȮǸ 
+  - dijkstraMatrix() :  8   Ž  interleaved multi-source Dijkstra
+                       帶 8 ĭ Ÿ,  ȭ SSE  8 ĭ  
+                        Z-order    ͳ 
+  - chMatrix()       : CH bucket  many-to-many
+                        backward upward Ž  庰 bucket  (, Ÿ) 
+                        forward upward Ž    bucket  Ⱦ  
+  - costMatrix()     :   chMatrix,  dijkstraMatrix
+   row-major float ,  Ұ INFINITY
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ch.h"
+#include "graph.h"
+#include "search.h"
+
+struct CostMatrix {
+    uint32_t rows = 0, cols = 0;
+    std::vector<float> data; // data[i * cols + j] : sources[i]  targets[j]
+
+    float at(uint32_t i, uint32_t j) const { return data[(size_t)i * cols + j]; }
+    const float* row(uint32_t i) const { return data.data() + (size_t)i * cols; }
+};
+
+// row[j] = source  targets[j] (weight[e] :  )
+void oneToMany(const Graph& g, SearchWorkspace& ws, Span<double> weight, uint32_t source,
+               const std::vector<uint32_t>& targets, float* row);
+
+void dijkstraMatrix(const Graph& g, Span<double> weight, const std::vector<uint32_t>& sources,
+                    const std::vector<uint32_t>& targets, CostMatrix& out, unsigned threads = 0);
+
+// ch      (buildCH(g, weight))
+void chMatrix(const CHGraph& ch, const std::vector<uint32_t>& sources, const std::vector<uint32_t>& targets,
+              CostMatrix& out, unsigned threads = 0);
+
+// ch  nullptr  ƴϸ CH bucket ( weight   ̾ ), ƴϸ 8   Dijkstra
+void costMatrix(const Graph& g, Span<double> weight, const CHGraph* ch, const std::vector<uint32_t>& sources,
+                const std::vector<uint32_t>& targets, CostMatrix& out, unsigned threads = 0);
@@ -0,0 +1,132 @@
+/*
+ parallel.h :   ݺ 
+  - parallelFor(n, threads, fn) : [0, n)    fn(tid, i) ȣ
+  - ۾  (chunk)   īͿ   庰  ޶  
+  - ThreadPool : 带    ΰ   parallelFor (  ݺؼ ó )
+*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+inline unsigned defaultThreads() {
+    unsigned t = std::thread::hardware_concurrency();
+    return t ? t : 1;
+}
+
+template <class Fn>
+void parallelFor(size_t n, unsigned threads, Fn&& fn, size_t chunk = 64) {
+    if (threads == 0) threads = defaultThreads();
+    threads = (unsigned)std::min<size_t>(threads, (n + chunk - 1) / chunk);
+    if (threads <= 1) {
+        for (size_t i = 0; i < n; i++) fn(0u, i);
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    auto worker = [&](unsigned tid) {
+        for (;;) {
+            size_t b = next.fetch_add(chunk);
+            if (b >= n) break;
+            size_t e = std::min(n, b + chunk);
+            for (size_t i = b; i < e; i++) fn(tid, i);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; t++) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+}
+
+/* ================================
+   ThreadPool :  ۾  
+   - parallelFor()  ȣ 嵵 tid 0  ϰ  ۾  ȯ
+   - tid  [0, size()) : 庰 ۾   
+   -    parallelFor  ( Ǯ  忡 ÿ ȣ )
+   ================================ */
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threads = 0) {
+        if (threads == 0) threads = defaultThreads();
+        for (unsigned t = 1; t < threads; t++) pool.emplace_back([this, t] { workerLoop(t); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lk(m);
+            stop = true;
+        }
+        wake.notify_all();
+        for (auto& th : pool) th.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return (unsigned)pool.size() + 1; }
+
+    template <class Fn>
+    void parallelFor(size_t n, Fn&& fn, size_t chunk = 16) {
+        if (n == 0) return;
+        if (pool.empty() || n <= chunk) {
+            for (size_t i = 0; i < n; i++) fn(0u, i);
+            return;
+        }
+        std::atomic<size_t> next(0);
+        std::function<void(unsigned)> job = [&](unsigned tid) {
+            for (;;) {
+                size_t b = next.fetch_add(chunk);
+                if (b >= n) break;
+                size_t e = std::min(n, b + chunk);
+                for (size_t i = b; i < e; i++) fn(tid, i);
+            }
+        };
+        {
+            std::lock_guard<std::mutex> lk(m);
+            current = &job;
+            busy = (unsigned)pool.size();
+            gen++;
+        }
+        wake.notify_all();
+        job(0);
+
+        std::unique_lock<std::mutex> lk(m);
+        done.wait(lk, [this] { return busy == 0; });
+        current = nullptr;
+    }
+
+private:
+    std::vector<std::thread> pool;
+    std::mutex m;
+    std::condition_variable wake, done;
+    std::function<void(unsigned)>* current = nullptr;
+    uint64_t gen = 0;
+    unsigned busy = 0;
+    bool stop = false;
+
+    void workerLoop(unsigned tid) {
+        uint64_t seen = 0;
+        for (;;) {
+            std::function<void(unsigned)>* job;
+            {
+                std::unique_lock<std::mutex> lk(m);
+                wake.wait(lk, [&] { return stop || gen != seen; });
+                if (stop) return;
+                seen = gen;
+                job = current;
+            }
+            (*job)(tid);
+            {
+                std::lock_guard<std::mutex> lk(m);
+                if (--busy == 0) done.notify_one();
+            }
+        }
+    }
+};
@@ -0,0 +1,271 @@
+#include "partition.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#include "parallel.h"
+
+using namespace std;
+
+namespace {
+
+/* -----------------------------------------
+   FlowNetwork :  뷮   + ʿõ/ʽũ (Dinic)
+   - arc k   k ^ 1 ( ߰)
+   -     뷮 1 (  ϳ), ʿõ/ʽũ  
+   ----------------------------------------- */
+class FlowNetwork {
+public:
+    static constexpr int32_t INF_CAP = numeric_limits<int32_t>::max() / 2;
+
+    explicit FlowNetwork(uint32_t nodes) : n(nodes), deg(nodes + 1, 0) {}
+
+    void addEdge(uint32_t u, uint32_t v, int32_t capUV, int32_t capVU) {
+        from.push_back(u); to.push_back(v); cap.push_back(capUV);
+        from.push_back(v); to.push_back(u); cap.push_back(capVU);
+    }
+
+    // arc   庰 CSR   ( arc ȣ Բ )
+    void finish() {
+        uint32_t m = (uint32_t)to.size();
+        fill(deg.begin(), deg.end(), 0);
+        for (uint32_t k = 0; k < m; k++) deg[from[k] + 1]++;
+        for (uint32_t u = 0; u < n; u++) deg[u + 1] += deg[u];
+        vector<uint32_t> pos(deg.begin(), deg.end() - 1), place(m);
+        for (uint32_t k = 0; k < m; k++) place[k] = pos[from[k]]++;
+        head.resize(m);
+        rcap.resize(m);
+        rev.resize(m);
+        for (uint32_t k = 0; k < m; k++) {
+            head[place[k]] = to[k];
+            rcap[place[k]] = cap[k];
+            rev[place[k]] = place[k ^ 1];
+        }
+        vector<uint32_t>().swap(from);
+        vector<uint32_t>().swap(to);
+        vector<int32_t>().swap(cap);
+    }
+
+    int64_t maxFlow(uint32_t s, uint32_t t) {
+        int64_t flow = 0;
+        level.resize(n);
+        it.resize(n);
+        while (bfs(s, t)) {
+            for (uint32_t u = 0; u < n; u++) it[u] = deg[u];
+            while (augment(s, t)) flow++;
+        }
+        return flow;
+    }
+
+    //  maxFlow  ܿ ׷ s ʿ   (ּ  source )
+    vector<uint8_t> sourceSide(uint32_t s) const {
+        vector<uint8_t> seen(n, 0);
+        vector<uint32_t> q{ s };
+        seen[s] = 1;
+        for (size_t h = 0; h < q.size(); h++) {
+            uint32_t u = q[h];
+            for (uint32_t k = deg[u]; k < deg[u + 1]; k++)
+                if (rcap[k] > 0 && !seen[head[k]]) { seen[head[k]] = 1; q.push_back(head[k]); }
+        }
+        return seen;
+    }
+
+private:
+    bool bfs(uint32_t s, uint32_t t) {
+        fill(level.begin(), level.end(), -1);
+        vector<uint32_t>& q = queue;
+        q.assign(1, s);
+        level[s] = 0;
+        for (size_t h = 0; h < q.size(); h++) {
+            uint32_t u = q[h];
+            for (uint32_t k = deg[u]; k < deg[u + 1]; k++) {
+                if (rcap[k] > 0 && level[head[k]] < 0) {
+                    level[head[k]] = level[u] + 1;
+                    q.push_back(head[k]);
+                }
+            }
+        }
+        return level[t] >= 0;
+    }
+
+    //  ׷   ϳ (ݺ DFS,    뷮̶ 1 )
+    bool augment(uint32_t s, uint32_t t) {
+        stack.clear();
+        uint32_t u = s;
+        for (;;) {
+            if (u == t) {
+                for (uint32_t k : stack) {
+                    rcap[k]--;
+                    rcap[rev[k]]++;
+                }
+                return true;
+            }
+            uint32_t& k = it[u];
+            while (k < deg[u + 1] && (rcap[k] <= 0 || level[head[k]] != level[u] + 1)) k++;
+            if (k == deg[u + 1]) {
+                level[u] = -1; //  
+                if (stack.empty()) return false;
+                uint32_t back = stack.back();
+                stack.pop_back();
+                u = head[rev[back]];
+                it[u]++;
+                continue;
+            }
+            stack.push_back(k);
+            u = head[k];
+        }
+    }
+
+    uint32_t n;
+    vector<uint32_t> deg, head, rev;
+    vector<int32_t> rcap;
+    vector<uint32_t> from, to;
+    vector<int32_t> cap;
+    vector<int32_t> level;
+    vector<uint32_t> it, queue, stack;
+};
+
+/* -----------------------------------------
+   bisect :  ϳ(nodes) ѷ (localOf   ۾ , ڱ  ĭ )
+   ----------------------------------------- */
+struct Split {
+    vector<uint32_t> a, b;
+};
+
+Split bisect(const Graph& g, const vector<uint32_t>& cellOf, vector<uint32_t>& localOf, uint32_t c,
+             const vector<uint32_t>& nodes, double balance) {
+    uint32_t k = (uint32_t)nodes.size();
+    for (uint32_t i = 0; i < k; i++) localOf[nodes[i]] = i;
+
+    //     ( ε ϳ)
+    vector<pair<uint32_t, uint32_t>> edges;
+    for (uint32_t i = 0; i < k; i++) {
+        uint32_t u = nodes[i];
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+            uint32_t v = g.target[e];
+            if (cellOf[v] == c && i < localOf[v]) edges.push_back({ i, localOf[v] });
+        }
+        for (uint32_t r = g.inBegin(u); r < g.inEnd(u); r++) {
+            uint32_t v = g.rSource[r];
+            if (cellOf[v] == c && i < localOf[v]) edges.push_back({ i, localOf[v] });
+        }
+    }
+    sort(edges.begin(), edges.end());
+    edges.erase(unique(edges.begin(), edges.end()), edges.end());
+
+    //  : , 浵(cos ),  밢
+    double meanLat = 0;
+    for (uint32_t u : nodes) meanLat += g.lat[u];
+    meanLat /= k;
+    double cx = cos(meanLat * M_PI / 180.0);
+    const double dirs[4][2] = { { 1, 0 }, { 0, 1 }, { 1, 1 }, { 1, -1 } };
+
+    uint32_t fixed = max<uint32_t>(1, min<uint32_t>(k / 2, (uint32_t)(k * balance)));
+    vector<uint32_t> order(k);
+    vector<double> proj(k);
+    vector<uint8_t> best;
+    int64_t bestCut = -1;
+    uint32_t bestGap = k;
+    for (auto& d : dirs) {
+        for (uint32_t i = 0; i < k; i++) {
+            order[i] = i;
+            proj[i] = d[0] * g.lat[nodes[i]] + d[1] * g.lon[nodes[i]] * cx;
+        }
+        sort(order.begin(), order.end(), [&proj](uint32_t a, uint32_t b) { return proj[a] < proj[b]; });
+
+        FlowNetwork net(k + 2);
+        uint32_t S = k, T = k + 1;
+        for (auto& e : edges) net.addEdge(e.first, e.second, 1, 1);
+        for (uint32_t i = 0; i < fixed; i++) {
+            net.addEdge(S, order[i], FlowNetwork::INF_CAP, 0);
+            net.addEdge(order[k - 1 - i], T, FlowNetwork::INF_CAP, 0);
+        }
+        net.finish();
+        int64_t cut = net.maxFlow(S, T);
+        vector<uint8_t> side = net.sourceSide(S);
+        uint32_t inA = 0;
+        for (uint32_t i = 0; i < k; i++) inA += side[i];
+        uint32_t gap = inA > k - inA ? inA - (k - inA) : (k - inA) - inA;
+        if (bestCut < 0 || cut < bestCut || (cut == bestCut && gap < bestGap)) {
+            bestCut = cut;
+            bestGap = gap;
+            best.assign(side.begin(), side.begin() + k);
+        }
+    }
+
+    Split s;
+    for (uint32_t i = 0; i < k; i++) (best[i] ? s.a : s.b).push_back(nodes[i]);
+    return s;
+}
+
+} // namespace
+
+uint32_t Partition::numBoundary() const {
+    uint32_t c = 0;
+    for (uint8_t b : boundary) c += b;
+    return c;
+}
+
+void finishPartition(const Graph& g, Partition& p) {
+    uint32_t n = g.numNodes();
+    p.cutEdges.clear();
+    p.boundary.assign(n, 0);
+    p.numCells = 0;
+    for (uint32_t u = 0; u < n; u++) p.numCells = max(p.numCells, p.cell[u] + 1);
+    for (uint32_t u = 0; u < n; u++) {
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+            uint32_t v = g.target[e];
+            if (p.cell[u] == p.cell[v]) continue;
+            p.cutEdges.push_back(e);
+            p.boundary[u] = p.boundary[v] = 1;
+        }
+    }
+}
+
+/* =========================================================
+   inertialFlow : ū  ܰ躰 ̵
+   -  ܰ  尡 ġ Ƿ  (cellOf  ܰ ̿ )
+   -     ( Ұ ʿ  ) ǥ  ߾ӿ ڸ
+   ========================================================= */
+Partition inertialFlow(const Graph& g, const PartitionOptions& opt) {
+    uint32_t n = g.numNodes();
+    uint32_t maxSize = max<uint32_t>(2, opt.maxCellSize);
+    vector<vector<uint32_t>> cells(1);
+    for (uint32_t u = 0; u < n; u++) cells[0].push_back(u);
+    vector<uint32_t> cellOf(n, 0), localOf(n, INVALID_NODE);
+
+    for (;;) {
+        vector<uint32_t> big;
+        for (uint32_t c = 0; c < cells.size(); c++)
+            if (cells[c].size() > maxSize) big.push_back(c);
+        if (big.empty()) break;
+
+        vector<Split> halves(big.size());
+        parallelFor(big.size(), opt.threads, [&](unsigned, size_t i) {
+            uint32_t c = big[i];
+            halves[i] = bisect(g, cellOf, localOf, c, cells[c], opt.balance);
+            if (halves[i].a.empty() || halves[i].b.empty()) {
+                vector<uint32_t> all = cells[c];
+                sort(all.begin(), all.end(), [&g](uint32_t x, uint32_t y) { return g.lat[x] < g.lat[y]; });
+                halves[i].a.assign(all.begin(), all.begin() + all.size() / 2);
+                halves[i].b.assign(all.begin() + all.size() / 2, all.end());
+            }
+        }, 1);
+
+        for (size_t i = 0; i < big.size(); i++) {
+            uint32_t c = big[i];
+            cells[c] = move(halves[i].a);
+            cells.push_back(move(halves[i].b));
+            for (uint32_t u : cells.back()) cellOf[u] = (uint32_t)cells.size() - 1;
+        }
+    }
+
+    Partition p;
+    p.cell = move(cellOf);
+    finishPartition(g, p);
+    return p;
+}
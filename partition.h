@@ -0,0 +1,33 @@
+/*
+ partition.h : ׷  (inertial flow)
+  -  ǥ 4 (, ,  밢)    balance  source / sink  
+  -  뷮 max-flow (Dinic)  ּ  ̵,     
+  -  maxCellSize ϰ   ݺ ( ܰ  ķ )
+  -  : 庰  ȣ,  ̸ մ  ,   (  )
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "graph.h"
+
+struct PartitionOptions {
+    uint32_t maxCellSize = 4096; //  ִ  
+    double balance = 0.25;       // ⸶ source / sink  ϴ   
+    unsigned threads = 0;        // 0 ̸ hardware_concurrency
+};
+
+struct Partition {
+    std::vector<uint32_t> cell;      //    ȣ
+    uint32_t numCells = 0;
+    std::vector<uint32_t> cutEdges;  //   ٸ   ȣ (  )
+    std::vector<uint8_t> boundary;   //   ̸ 1
+
+    uint32_t numBoundary() const;
+};
+
+Partition inertialFlow(const Graph& g, const PartitionOptions& opt = PartitionOptions());
+
+//  ȣ ׷   /   ٽ  (   )
+void finishPartition(const Graph& g, Partition& p);
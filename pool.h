@@ -0,0 +1,130 @@
+/*
+ pool.h :  Ҵ ִ Ǯ(arena) 
+  - StringPool : ڿ intern ǥ,  ڸ  ۿ ̾ ̰ ȣ 
+                 (ڿ/ؽ 帶 ϴ Ҵ , ׷ id ̺  ״ Ѱ)
+  - PathPool   :    ȣ  ۿ ̾ ̰ (, )  
+                 (Ǹ vector Ҵ , clear() Ŀ 뷮 )
+*/
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/* ================================
+   StringPool
+   - chars_[offset_[i] .. offset_[i+1]) : i  ڿ
+   - slots_ :  ּ(open addressing) ؽ ǥ, ڿ ȣ  ( ĭ = NONE)
+   - release() : ۸ ° ѱ  (ٽ ε    )
+   ================================ */
+class StringPool {
+public:
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    StringPool() { offset_.push_back(0); }
+
+    uint32_t size() const { return (uint32_t)offset_.size() - 1; }
+    std::string_view operator[](uint32_t i) const {
+        return std::string_view(chars_.data() + offset_[i], offset_[i + 1] - offset_[i]);
+    }
+
+    void reserve(size_t strings, size_t chars) {
+        offset_.reserve(strings + 1);
+        hash_.reserve(strings);
+        chars_.reserve(chars);
+    }
+
+    //  NONE
+    uint32_t find(std::string_view s) const {
+        if (slots_.empty()) return NONE;
+        uint32_t h = hashOf(s), mask = (uint32_t)slots_.size() - 1;
+        for (uint32_t i = h & mask;; i = (i + 1) & mask) {
+            uint32_t k = slots_[i];
+            if (k == NONE) return NONE;
+            if (hash_[k] == h && (*this)[k] == s) return k;
+        }
+    }
+
+    // ̹   ȣ,  ߰   ȣ
+    uint32_t intern(std::string_view s) {
+        if ((size() + 1) * 2 > slots_.size()) grow();
+        uint32_t h = hashOf(s), mask = (uint32_t)slots_.size() - 1;
+        uint32_t i = h & mask;
+        for (;; i = (i + 1) & mask) {
+            uint32_t k = slots_[i];
+            if (k == NONE) break;
+            if (hash_[k] == h && (*this)[k] == s) return k;
+        }
+        uint32_t k = size();
+        slots_[i] = k;
+        hash_.push_back(h);
+        chars_.insert(chars_.end(), s.begin(), s.end());
+        offset_.push_back((uint32_t)chars_.size());
+        return k;
+    }
+
+    // (offset, chars)  Ѱְ ؽ ǥ  
+    void release(std::vector<uint32_t>& offset, std::vector<char>& chars) {
+        offset = std::move(offset_);
+        chars = std::move(chars_);
+        clear();
+    }
+
+    void clear() {
+        std::vector<char>().swap(chars_);
+        std::vector<uint32_t>().swap(offset_);
+        std::vector<uint32_t>().swap(hash_);
+        std::vector<uint32_t>().swap(slots_);
+        offset_.push_back(0);
+    }
+
+private:
+    // FNV-1a
+    static uint32_t hashOf(std::string_view s) {
+        uint32_t h = 2166136261u;
+        for (unsigned char c : s) h = (h ^ c) * 16777619u;
+        return h;
+    }
+
+    void grow() {
+        size_t cap = slots_.empty() ? 1024 : slots_.size() * 2;
+        slots_.assign(cap, NONE);
+        uint32_t mask = (uint32_t)cap - 1;
+        for (uint32_t k = 0; k < size(); k++) {
+            uint32_t i = hash_[k] & mask;
+            while (slots_[i] != NONE) i = (i + 1) & mask;
+            slots_[i] = k;
+        }
+    }
+
+    std::vector<char> chars_;
+    std::vector<uint32_t> offset_;
+    std::vector<uint32_t> hash_;   // ڿ ؽ (ǥ Ű  ٽ  )
+    std::vector<uint32_t> slots_;  // ũ 2  ŵ,  50% 
+};
+
+/* ================================
+   PathPool :   ȣ ̾  
+   - add(path)  PathRef (   ġ, )
+   -   clear()  ȿ
+   ================================ */
+struct PathRef {
+    uint32_t begin = 0;
+    uint32_t size = 0;
+};
+
+class PathPool {
+public:
+    PathRef add(const std::vector<uint32_t>& path) {
+        PathRef r{ (uint32_t)nodes_.size(), (uint32_t)path.size() };
+        nodes_.insert(nodes_.end(), path.begin(), path.end());
+        return r;
+    }
+    const uint32_t* data(PathRef r) const { return nodes_.data() + r.begin; }
+    size_t size() const { return nodes_.size(); }
+    void clear() { nodes_.clear(); }
+
+private:
+    std::vector<uint32_t> nodes_;
+};
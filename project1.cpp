@@ -2,180 +2,145 @@
 #include <unordered_map>
 #include <vector>
 #include <string>
-#include <queue>
 #include <algorithm>
 #include <iomanip>
 #include <chrono>
 #include <cmath>
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-#include "tinyxml2.h"
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include "graph.h"
+#include "search.h"
+#include "cch.h"
+#include "snapshot.h"
+#include "live.h"
+#include "turn.h"
+#include "isochrone.h"
+#include "timedep.h"
 
 using namespace std;
-using namespace tinyxml2;
 
 /* =====================  ===================== */
 const double AVG_SPEED = 13.9; // m/s
-static constexpr double R = 6371000.0;
-
-/* ===================== ü ===================== */
-struct Node {
-    string id;
-    double lat = 0.0;
-    double lon = 0.0;
-};
-
-struct EdgeInfo {
-    double length = 0.0;
-    string roadName;
-};
+const int ISOCHRONE_SEC = 300; //     (5)
 
 /* =====================  ===================== */
-unordered_map<string, Node> nodes;
-unordered_map<string, vector<pair<string, double>>> adj;
-unordered_map<string, unordered_map<string, EdgeInfo>> edgeInfoMap;
-unordered_map<string, unordered_map<string, double>> trafficDelay;
-unordered_map<string, string> keyIdToName;
-
-/* ===================== ƿ ===================== */
-double haversine(double lat1, double lon1, double lat2, double lon2) {
-    auto rad = [](double d) { return d * M_PI / 180.0; };
-    double dlat = rad(lat2 - lat1), dlon = rad(lon2 - lon1);
-    double a = sin(dlat / 2) * sin(dlat / 2)
-        + cos(rad(lat1)) * cos(rad(lat2))
-        * sin(dlon / 2) * sin(dlon / 2);
-    return 2 * R * atan2(sqrt(a), sqrt(1 - a));
-}
-
-string localName(const char* name) {
-    if (!name) return "";
-    string s = name;
-    size_t p = s.find_last_of(":}");
-    return (p != string::npos) ? s.substr(p + 1) : s;
-}
-
-/* ===================== GraphML ε ===================== */
+Graph graph;
+SearchWorkspace workspace; //   Ǵ Ž 
+BidirectionalWorkspace biWorkspace;
+CCH cch;                   //    (׷ ε   )
+unique_ptr<LiveTraffic> traffic; // ȣ  + customize  (Ÿ  )
+TurnTable turns;           // ȸ  / ȸ  (turns.txt)
+SearchWorkspace turnWorkspace; //   Ž (  ũ)
+ProfilePool profiles;      // ð뺰 ȥ  ( ޺)
+TimeDependentCost tdCost;  //    ð +  ȣ
+
+/* ===================== GraphML ε (  mmap) ===================== */
 bool loadGraphML(const string& file) {
-    XMLDocument doc;
-    if (doc.LoadFile(file.c_str()) != XML_SUCCESS) return false;
-    XMLElement* root = doc.RootElement();
-    if (!root) return false;
-
-    for (auto* key = root->FirstChildElement(); key; key = key->NextSiblingElement()) {
-        if (localName(key->Name()) != "key") continue;
-        const char* id = key->Attribute("id");
-        const char* attr = key->Attribute("attr.name");
-        if (id && attr) keyIdToName[id] = attr;
-    }
-
-    XMLElement* graph = root->FirstChildElement("graph");
-    if (!graph) graph = root;
-
-    for (auto* n = graph->FirstChildElement(); n; n = n->NextSiblingElement()) {
-        if (localName(n->Name()) != "node") continue;
-        const char* id = n->Attribute("id");
-        if (!id) continue;
-
-        Node nd; nd.id = id;
-        for (auto* d = n->FirstChildElement(); d; d = d->NextSiblingElement()) {
-            if (localName(d->Name()) != "data") continue;
-            const char* key = d->Attribute("key");
-            const char* text = d->GetText();
-            if (!key || !text) continue;
-
-            string attr = keyIdToName[key];
-            double v = atof(text);
-            if (attr == "lat" || attr == "y" || key == string("d4"))
-                nd.lat = v;
-            else if (attr == "lon" || attr == "x" || key == string("d5"))
-                nd.lon = v;
-        }
-        nodes[id] = nd;
-        adj[id];
-    }
-
-    for (auto* e = graph->FirstChildElement(); e; e = e->NextSiblingElement()) {
-        if (localName(e->Name()) != "edge") continue;
-        const char* s = e->Attribute("source");
-        const char* t = e->Attribute("target");
-        if (!s || !t) continue;
-
-        double length = haversine(nodes[s].lat, nodes[s].lon,
-            nodes[t].lat, nodes[t].lon);
+    GraphMLOptions opt;
+    opt.useLengthAttr = false; // ǥ  Ÿ
+    opt.honourOneway = false;  //   
+    return loadGraph(file, graph, opt);
+}
 
-        adj[s].push_back({ t, length });
-        edgeInfoMap[s][t] = { length, "" };
-        adj[t].push_back({ s, length });
-        edgeInfoMap[t][s] = { length, "" };
-    }
-    return true;
+/* =====================   ( ð, ȣ  TrafficState  ) ===================== */
+vector<double> baseTravelTime() {
+    vector<double> w(graph.numEdges());
+    for (uint32_t e = 0; e < graph.numEdges(); e++) w[e] = graph.length[e] / AVG_SPEED;
+    return w;
 }
 
 /* ===================== Dijkstra (ð ) ===================== */
-pair<vector<string>, double> dijkstra(const string& start, const string& goal) {
-    unordered_map<string, double> dist;
-    unordered_map<string, string> prev;
-
-    for (auto& kv : nodes) dist[kv.first] = 1e18;
-    dist[start] = 0;
-
-    priority_queue<pair<double, string>,
-        vector<pair<double, string>>, greater<>> pq;
-    pq.push({ 0, start });
+pair<vector<uint32_t>, double> dijkstra(uint32_t start, uint32_t goal) {
+    auto snap = traffic->current();
+    double total = dijkstra(graph, workspace, start, goal, *snap);
+    if (total >= INF_DIST) return { {}, -1 };
+
+    vector<uint32_t> path;
+    workspace.path(goal, path);
+    return { path, total };
+}
 
-    while (!pq.empty()) {
-        auto [cd, u] = pq.top(); pq.pop();
-        if (u == goal) break;
+/* ===================== A* (ð ) ===================== */
+// ޸ƽ : Ÿ / AVG_SPEED ( θ AVG_SPEED  ޸Ƿ )
+pair<vector<uint32_t>, double> astar(uint32_t start, uint32_t goal) {
+    StraightLineHeuristic h(graph, goal, 1.0 / AVG_SPEED);
+    auto snap = traffic->current();
+    double total = astar(graph, workspace, start, goal, *snap, h);
+    if (total >= INF_DIST) return { {}, -1 };
+
+    vector<uint32_t> path;
+    workspace.path(goal, path);
+    return { path, total };
+}
 
-        for (auto& pr : adj[u]) {
-            string v = pr.first;
-            double w = pr.second;
+/* ===================== ȸ  ݿ ( ) ===================== */
+pair<vector<uint32_t>, double> turnRoute(uint32_t start, uint32_t goal) {
+    auto snap = traffic->current();
+    uint32_t last;
+    double total = turnDijkstra(graph, turnWorkspace, start, goal, *snap, turns, &last);
+    if (total >= INF_DIST) return { {}, -1 };
+
+    vector<uint32_t> path;
+    if (start == goal) path.push_back(start);
+    else turnPath(graph, turnWorkspace, turns, last, path);
+    return { path, total };
+}
 
-            double travelTime = w / AVG_SPEED;
-            double lightDelay = 0.0;
+/* ===================== CCH (customizable) ===================== */
+// ȣ  ٲ  ״ ΰ customization  ٽ  (LiveTraffic  ٲ κи)
+pair<vector<uint32_t>, double> cchRoute(const TrafficState& state, uint32_t start, uint32_t goal) {
+    double total = cchQuery(cch, state.metric, biWorkspace, start, goal);
+    if (total >= INF_DIST) return { {}, -1 };
 
-            if (trafficDelay.count(u) && trafficDelay[u].count(v)) {
-                lightDelay = trafficDelay[u][v];
-            }
+    vector<uint32_t> path;
+    cchPath(cch, state.metric, biWorkspace, path);
+    return { path, total };
+}
 
-            double cost = cd + travelTime + lightDelay;
+/* ===================== ð  A* ( ð ) ===================== */
+//  ð ȥ  ϰ ȣ (  -   ð) ״ 
+pair<vector<uint32_t>, double> tdRoute(uint32_t start, uint32_t goal, double departure) {
+    auto snap = traffic->current();
+    auto cost = [&](uint32_t u, uint32_t e, double t) { return tdCost(u, e, t) + (snap->weight[e] - tdCost.base[e]); };
+    double arrive = tdAstar(graph, workspace, start, goal, departure, cost, tdHeuristic(graph, tdCost, goal, AVG_SPEED));
+    if (arrive >= INF_DIST) return { {}, -1 };
+
+    vector<uint32_t> path;
+    workspace.path(goal, path);
+    return { path, arrive - departure };
+}
 
-            if (dist[v] > cost) {
-                dist[v] = cost;
-                prev[v] = u;
-                pq.push({ dist[v], v });
+/* ===================== main ===================== */
+// ڷ   ָ ("-"  ǥ Է) ù  ڿ    CCH θ ٽ 
+// --depart HH:MM : ð    ð (⺻ 08:00)
+int main(int argc, char** argv) {
+    int depH = 8, depM = 0;
+    string feed;
+    for (int i = 1; i < argc; i++) {
+        string a = argv[i];
+        if (a == "--depart" && i + 1 < argc) {
+            int h, m;
+            char c;
+            istringstream ds(argv[++i]);
+            if (!(ds >> h >> c >> m) || c != ':' || h < 0 || h >= 24 || m < 0 || m >= 60) {
+                cout << "Invalid departure time (HH:MM): " << argv[i] << "\n";
+                return 0;
             }
+            depH = h;
+            depM = m;
+        } else {
+            feed = a;
         }
     }
 
-    if (dist[goal] >= 1e18) return { {}, -1 };
-
-    vector<string> path;
-    for (string cur = goal; ; cur = prev[cur]) {
-        path.push_back(cur);
-        if (cur == start) break;
-    }
-    reverse(path.begin(), path.end());
-    return { path, dist[goal] };
-}
-
-/* ===================== ¿ ===================== */
-string toDash(const vector<string>& p) {
-    string s;
-    for (size_t i = 0; i < p.size(); i++) {
-        s += p[i];
-        if (i + 1 < p.size()) s += "-";
-    }
-    return s;
-}
-
-/* ===================== main ===================== */
-int main() {
     if (!loadGraphML("jongro.graphml")) {
         cout << "Graph load failed\n";
         return 0;
     }
+    cch = buildCCH(graph);
+    turns.build(graph);
+    loadTurnRestrictions("turns.txt", graph, turns); //  ⺻ ȸ 븸
 
     string s, d;
     cout << "Start node id: ";
@@ -187,15 +152,28 @@ int main() {
     cout << "ȣ  Է: ";
     cin >> n;
 
+    vector<DelayUpdate> signals;
     for (int i = 0; i < n; i++) {
         string from, to;
         double delay;
         cout << "from to delay(sec): ";
         cin >> from >> to >> delay;
-        trafficDelay[from][to] = delay;
+        uint32_t fu = graph.find(from), tu = graph.find(to);
+        if (fu != INVALID_NODE && tu != INVALID_NODE) signals.push_back({ fu, tu, delay });
+    }
+    traffic = make_unique<LiveTraffic>(graph, baseTravelTime(), &cch);
+    traffic->apply(signals);
+    tdCost = TimeDependentCost(profiles, baseTravelTime());
+    assignHighwayProfiles(graph, profiles, tdCost);
+    double departure = depH * 3600.0 + depM * 60.0;
+
+    uint32_t su = graph.find(s), du = graph.find(d);
+    if (su == INVALID_NODE || du == INVALID_NODE) {
+        cout << " \n";
+        return 0;
     }
 
-    auto [path, totalTime] = dijkstra(s, d);
+    auto [path, totalTime] = dijkstra(su, du);
 
     if (path.empty()) {
         cout << " \n";
@@ -204,7 +182,47 @@ int main() {
 
     cout << fixed << setprecision(3);
     cout << "[Dijkstra] Total travel time (sec): " << totalTime << "\n";
-    cout << "[Dijkstra] Vehicle route: " << toDash(path) << "\n";
+    cout << "[Dijkstra] Vehicle route: " << toDash(graph, path) << "\n";
+
+    auto [apath, aTime] = astar(su, du);
+    cout << "[A*] Total travel time (sec): " << aTime << "\n";
+    cout << "[A*] Vehicle route: " << toDash(graph, apath) << "\n";
+
+    auto [tpath, tTime] = turnRoute(su, du);
+    cout << "[Turn] Total travel time (sec): " << tTime << "\n";
+    cout << "[Turn] Vehicle route: " << toDash(graph, tpath) << "\n";
+
+    auto [cpath, cTime] = cchRoute(*traffic->current(), su, du);
+    cout << "[CCH] Total travel time (sec): " << cTime << "\n";
+    cout << "[CCH] Vehicle route: " << toDash(graph, cpath) << "\n";
+
+    auto [dpath, dTime] = tdRoute(su, du, departure);
+    ostringstream depTag;
+    depTag << "[TD " << setw(2) << setfill('0') << depH << ":" << setw(2) << depM << setfill(' ') << "]";
+    cout << depTag.str() << " Total travel time (sec): " << dTime << "\n";
+    cout << depTag.str() << " Vehicle route: " << toDash(graph, dpath) << "\n";
+
+    //  ISOCHRONE_SEC ȿ   ִ 
+    Isochrone iso;
+    reachable(graph, workspace, su, ISOCHRONE_SEC, traffic->current()->weight, iso);
+    auto polygon = isochronePolygon(graph, iso);
+    cout << "[Isochrone " << ISOCHRONE_SEC << "s] Reachable intersections: " << iso.nodes.size()
+         << ", boundary roads: " << iso.boundary.size() << ", polygon vertices: " << polygon.size() << "\n";
+
+    if (!feed.empty()) {
+        ifstream file;
+        if (feed != "-") file.open(feed);
+        istream& in = feed == "-" ? cin : file;
+        if (!in) {
+            cout << "Update feed open failed: " << feed << "\n";
+            return 0;
+        }
+        traffic->consume(in, 256, [&](const TrafficState& state) {
+            auto [lpath, lTime] = cchRoute(state, su, du);
+            cout << "[Live v" << state.version << "] Total travel time (sec): " << lTime << "\n";
+            cout << "[Live v" << state.version << "] Vehicle route: " << toDash(graph, lpath) << "\n";
+        });
+    }
 
     return 0;
 }
@@ -0,0 +1,190 @@
+#include "sampler.h"
+
+#include <atomic>
+#include <cmath>
+
+#include "parallel.h"
+#include "search.h"
+
+using namespace std;
+
+namespace {
+
+// ȱ i   : counter = (i,  ȣ),  ϳ  4 
+class WalkRandom {
+public:
+    WalkRandom(uint64_t seed, uint32_t walk) : ph(seed) {
+        ph.ctr[0] = walk;
+    }
+
+    // [0, n) յ (-Ʈ)
+    uint32_t below(uint32_t n) {
+        return (uint32_t)(((uint64_t)next() * n) >> 32);
+    }
+
+    // [0, 1) յ
+    double unit() { return next() * (1.0 / 4294967296.0); }
+
+private:
+    Philox4x32 ph;
+    uint32_t buf[4];
+    int used = 4;
+
+    uint32_t next() {
+        if (used == 4) {
+            ph.block(buf);
+            ph.ctr[1]++;
+            used = 0;
+        }
+        return buf[used++];
+    }
+};
+
+// (, , ȣ)  
+bool better(uint32_t steps, double len, uint32_t walk, const WalkResult& b, bool haveB) {
+    if (!haveB) return true;
+    if (steps != b.steps) return steps < b.steps;
+    if (len != b.length) return len < b.length;
+    return walk < b.walk;
+}
+
+} // namespace
+
+/* =========================================================
+   goal   ( ׷)
+   - hops[u] :    (BFS),    UINT32_MAX
+   - dist[u] :   (Dijkstra)
+   ========================================================= */
+static void goalBounds(const Graph& g, uint32_t goal, vector<uint32_t>& hops, vector<double>& dist) {
+    uint32_t n = g.numNodes();
+    hops.assign(n, UINT32_MAX);
+    vector<uint32_t> queue;
+    queue.reserve(n);
+    hops[goal] = 0;
+    queue.push_back(goal);
+    for (size_t h = 0; h < queue.size(); h++) {
+        uint32_t v = queue[h];
+        for (uint32_t k = g.inBegin(v); k < g.inEnd(v); k++) {
+            uint32_t u = g.rSource[k];
+            if (hops[u] == UINT32_MAX) {
+                hops[u] = hops[v] + 1;
+                queue.push_back(u);
+            }
+        }
+    }
+
+    dist.assign(n, INF_DIST);
+    QuadHeap pq;
+    pq.resize(n);
+    dist[goal] = 0;
+    pq.push(goal, 0);
+    while (!pq.empty()) {
+        auto [d, v] = pq.pop();
+        for (uint32_t k = g.inBegin(v); k < g.inEnd(v); k++) {
+            uint32_t u = g.rSource[k];
+            double nd = d + g.length[g.rEdge[k]];
+            if (nd < dist[u]) {
+                dist[u] = nd;
+                pq.push(u, nd);
+            }
+        }
+    }
+}
+
+/* =========================================================
+    ȱ ǥ
+   - 帶 ڱ ּ ĺ ΰ  ħ (    ׻ )
+   - ġ : ݱ  + hops  ּ (ü ) ũ ߴ
+                  +   ּ (庰) Ŭ  ߴ
+                 ּ Ȯ  ȱ⸸ Ƿ  ġ   
+   -  ۴ 庰 , ּ ٲ  
+   ========================================================= */
+WalkResult randomWalkSample(const Graph& g, uint32_t start, uint32_t goal, const WalkOptions& opt) {
+    WalkResult best;
+    if (start >= g.numNodes() || goal >= g.numNodes()) return best;
+
+    vector<uint32_t> hops;
+    vector<double> lower;
+    goalBounds(g, goal, hops, lower);
+    if (hops[start] == UINT32_MAX || hops[start] > opt.maxSteps) return best; //  ȱ⵵  
+
+    StraightLineHeuristic h(g, goal);
+    unsigned threads = opt.threads ? opt.threads : defaultThreads();
+    struct Local {
+        WalkResult best;
+        bool have = false;
+        vector<uint32_t> path;
+        vector<double> weight;
+        uint64_t walked = 0;
+        uint32_t reached = 0;
+    };
+    vector<Local> local(threads);
+    atomic<uint32_t> bestSteps(opt.maxSteps); //  尡 ϴ  
+
+    parallelFor(opt.walks, threads, [&](unsigned tid, size_t i) {
+        Local& L = local[tid];
+        WalkRandom rnd(opt.seed, (uint32_t)i);
+        L.path.clear();
+        L.path.push_back(start);
+
+        uint32_t cur = start;
+        double len = 0;
+        for (uint32_t st = 0; cur != goal; st++) {
+            //  ˻ :  ȱⰡ ּ ̱   ߴ
+            uint32_t bound = bestSteps.load(memory_order_relaxed);
+            if (hops[cur] == UINT32_MAX || st + hops[cur] > bound) break;
+            if (L.have && st + hops[cur] == L.best.steps && len + lower[cur] > L.best.length) break;
+
+            uint32_t deg = g.degree(cur);
+            if (deg == 0) break;
+            uint32_t e = g.edgeBegin(cur);
+            if (opt.bias > 0) {
+                //    ϼ  : exp(-bias * (Ÿ ȭ /  ))
+                L.weight.resize(deg);
+                double hc = h(cur), sum = 0;
+                for (uint32_t k = 0; k < deg; k++) {
+                    uint32_t ek = e + k;
+                    double dl = max(g.length[ek], 1.0);
+                    sum += L.weight[k] = exp(-opt.bias * (h(g.target[ek]) - hc) / dl);
+                }
+                double r = rnd.unit() * sum;
+                uint32_t k = 0;
+                while (k + 1 < deg && (r -= L.weight[k]) >= 0) k++;
+                e += k;
+            } else {
+                e += rnd.below(deg);
+            }
+            len += g.length[e];
+            cur = g.target[e];
+            L.path.push_back(cur);
+        }
+        L.walked += L.path.size() - 1;
+
+        uint32_t steps = (uint32_t)L.path.size() - 1;
+        L.reached += cur == goal;
+        if (cur == goal && better(steps, len, (uint32_t)i, L.best, L.have)) {
+            L.best.path = L.path;
+            L.best.steps = steps;
+            L.best.length = len;
+            L.best.walk = (uint32_t)i;
+            L.have = true;
+            uint32_t b = bestSteps.load(memory_order_relaxed);
+            while (steps < b && !bestSteps.compare_exchange_weak(b, steps, memory_order_relaxed)) {}
+        }
+    }, 16);
+
+    bool have = false;
+    uint64_t walked = 0;
+    uint32_t reached = 0;
+    for (auto& L : local) {
+        walked += L.walked;
+        reached += L.reached;
+        if (L.have && better(L.best.steps, L.best.length, L.best.walk, best, have)) {
+            best = move(L.best);
+            have = true;
+        }
+    }
+    best.walkedSteps = walked;
+    best.reached = reached;
+    return best;
+}
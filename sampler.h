@@ -0,0 +1,61 @@
+/*
+ sampler.h : Monte Carlo   ǥ (  /  پ缺 ǥ)
+  - ȱ(walk)   : start      goal  ų maxSteps 
+  -   ȱ :     ,  ̰ ª ,  ȣ  
+  -  : Philox4x32-10 (counter )  ȱ i   (seed, i) θ 
+           seed   
+  - ȱ   , ̴ 鼭  ̸ ٷ 
+  - ġ : goal  /  ̹ ּ ̱   ȱ ߴ
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "graph.h"
+
+/* ================================
+   Philox4x32-10 : 128Ʈ counter + 64Ʈ key  128Ʈ 
+   ================================ */
+struct Philox4x32 {
+    uint32_t key[2];
+    uint32_t ctr[4] = { 0, 0, 0, 0 };
+
+    explicit Philox4x32(uint64_t seed) : key{ (uint32_t)seed, (uint32_t)(seed >> 32) } {}
+
+    //  counter    (counter  ٲ )
+    void block(uint32_t out[4]) const {
+        uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int r = 0; r < 10; r++) {
+            uint64_t p0 = (uint64_t)0xD2511F53u * c0, p1 = (uint64_t)0xCD9E8D57u * c2;
+            uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0, n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+            c1 = (uint32_t)p1;
+            c3 = (uint32_t)p0;
+            c0 = n0;
+            c2 = n2;
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+    }
+};
+
+struct WalkOptions {
+    uint32_t walks = 2000;     // ȱ Ƚ (M)
+    uint32_t maxSteps = 1000;  // ȱ ִ  (N)
+    uint64_t seed = 0;
+    unsigned threads = 0;      // 0 ̸ hardware_concurrency
+    double bias = 0;           // 0 ̸ յ , Ŭ Ÿ(A* ޸ƽ) پ  ȣ
+};
+
+struct WalkResult {
+    std::vector<uint32_t> path; //   ȱⰡ   
+    uint32_t steps = 0;         //   
+    double length = 0;          //     ()
+    uint32_t walk = 0;          //  ° ȱ
+    uint64_t walkedSteps = 0;   // ġ      (   ޶  )
+    uint32_t reached = 0;       //   ȱ  ( ߴ : ġ, ٸ ,  ѵ)
+};
+
+WalkResult randomWalkSample(const Graph& g, uint32_t start, uint32_t goal, const WalkOptions& opt = WalkOptions());
@@ -0,0 +1,404 @@
+/*
+ search.h :   Ž ۾  + Dijkstra
+  - dist/prev/heap ۸ ̸ Ҵ ΰ Ǹ 
+  - (generation) ȣ ʱȭ  reset()  O(1)
+  - ۾  ϳ SearchWorkspace ϳ  õ  
+  - 켱 ť ø ڷ ü  (heap.h)
+  - astar() : Ÿ  ̿ ǥ  Ž
+  - dijkstraMulti() :  /  ( ߰ ߡ)
+  -  : ۾  Stats  (stats.h)  ⺻ NoStats   
+*/
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+#include "heap.h"
+#include "stats.h"
+
+static constexpr double INF_DIST = 1e18;
+
+/* ================================
+   BasicSearchWorkspace : Ǵ  
+   - stamp[u] == gen  常 ̹ ǿ ȿ
+   - Queue : 켱 ť å (BinaryHeap / QuadHeap / RadixHeap)
+   - Stats :  å (NoStats / SearchStats),     ʿ  stats.clear()
+   ================================ */
+template <class Queue, class Stats = NoStats>
+class BasicSearchWorkspace {
+public:
+    BasicSearchWorkspace() = default;
+    explicit BasicSearchWorkspace(uint32_t n) { resize(n); }
+
+    void resize(uint32_t n) {
+        queue.resize(n);
+        dist_.resize(n);
+        prev_.resize(n);
+        stamp_.assign(n, 0);
+        gen_ = 0;
+    }
+    uint32_t size() const { return (uint32_t)stamp_.size(); }
+
+    //   غ :  ȣ ø (32Ʈ ħ ÿ ü ʱȭ)
+    void reset() {
+        queue.clear();
+        if (++gen_ == 0) {
+            std::fill(stamp_.begin(), stamp_.end(), 0);
+            gen_ = 1;
+        }
+    }
+
+    bool reached(uint32_t u) const { return stamp_[u] == gen_; }
+    double dist(uint32_t u) const { return reached(u) ? dist_[u] : INF_DIST; }
+    uint32_t prev(uint32_t u) const { return reached(u) ? prev_[u] : INVALID_NODE; }
+
+    void set(uint32_t u, double d, uint32_t p) {
+        stamp_[u] = gen_;
+        dist_[u] = d;
+        prev_[u] = p;
+    }
+
+    // goal  prev     (out  )
+    void path(uint32_t goal, std::vector<uint32_t>& out) const {
+        out.clear();
+        if (!reached(goal)) return;
+        for (uint32_t cur = goal; cur != INVALID_NODE; cur = prev_[cur]) out.push_back(cur);
+        std::reverse(out.begin(), out.end());
+    }
+
+    // Ž (frontier) ť (capacity )
+    Queue queue;
+    Stats stats;
+
+private:
+    std::vector<double> dist_;
+    std::vector<uint32_t> prev_;
+    std::vector<uint32_t> stamp_;
+    uint32_t gen_ = 0;
+};
+
+using SearchWorkspace = BasicSearchWorkspace<QuadHeap>;
+using InstrumentedWorkspace = BasicSearchWorkspace<QuadHeap, SearchStats>;
+
+/* =========================================================
+   Dijkstra ִ  (start  goal)
+   - cost(u, e) :  e (u   ) 
+   - ȯ : goal   ( Ұ INF_DIST)
+   - δ ws.path(goal, out)  
+   - lazy ť(BinaryHeap, RadixHeap)  Ҵ   ǳʶ
+   ========================================================= */
+template <class Queue, class Stats, class Cost>
+double dijkstra(const Graph& g, BasicSearchWorkspace<Queue, Stats>& ws, uint32_t start, uint32_t goal, Cost&& cost) {
+    if (ws.size() != g.numNodes()) ws.resize(g.numNodes());
+    ws.reset();
+
+    auto& pq = ws.queue;
+    auto& st = ws.stats;
+    st.query();
+    ws.set(start, 0, INVALID_NODE);
+    pq.push(start, 0);
+    st.push(pq.size());
+
+    while (!pq.empty()) {
+        auto [cd, u] = pq.pop();
+        if (cd > ws.dist(u)) { st.stale(); continue; }
+        st.settle();
+        if (u == goal) break;
+
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+            uint32_t v = g.target[e];
+            double nd = cd + cost(u, e);
+            st.relax();
+            if (ws.dist(v) > nd) {
+                ws.set(v, nd, u);
+                pq.push(v, nd);
+                st.push(pq.size());
+            }
+        }
+    }
+    return ws.dist(goal);
+}
+
+//  ()  Dijkstra
+template <class Queue, class Stats>
+double dijkstra(const Graph& g, BasicSearchWorkspace<Queue, Stats>& ws, uint32_t start, uint32_t goal) {
+    return dijkstra(g, ws, start, goal, [&g](uint32_t, uint32_t e) { return g.length[e]; });
+}
+
+/* ================================
+   RouteEndpoint :  ߰ /     () κ 
+   ================================ */
+struct RouteEndpoint {
+    uint32_t node;
+    double cost;
+};
+
+/* =========================================================
+     /   Dijkstra
+   - sources[i].cost  ʱ Ÿ   忡 ÿ 
+   -   = dist(node) + targets[j].cost  ּ,  Ÿ   ̸̻ 
+   - *bestTarget : ּҸ    (δ ws.path(*bestTarget, out))
+   ========================================================= */
+template <class Queue, class Stats, class Cost>
+double dijkstraMulti(const Graph& g, BasicSearchWorkspace<Queue, Stats>& ws, const std::vector<RouteEndpoint>& sources,
+                     const std::vector<RouteEndpoint>& targets, Cost&& cost, uint32_t* bestTarget = nullptr) {
+    if (ws.size() != g.numNodes()) ws.resize(g.numNodes());
+    ws.reset();
+
+    auto& pq = ws.queue;
+    auto& st = ws.stats;
+    st.query();
+    for (auto& s : sources) {
+        if (s.cost < ws.dist(s.node)) {
+            ws.set(s.node, s.cost, INVALID_NODE);
+            pq.push(s.node, s.cost);
+            st.push(pq.size());
+        }
+    }
+
+    double best = INF_DIST;
+    uint32_t bestNode = INVALID_NODE;
+    while (!pq.empty()) {
+        auto [cd, u] = pq.pop();
+        if (cd > ws.dist(u)) { st.stale(); continue; }
+        if (cd >= best) break;
+        st.settle();
+
+        for (auto& t : targets) {
+            if (t.node == u && cd + t.cost < best) {
+                best = cd + t.cost;
+                bestNode = u;
+            }
+        }
+
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+            uint32_t v = g.target[e];
+            double nd = cd + cost(u, e);
+            st.relax();
+            if (ws.dist(v) > nd) {
+                ws.set(v, nd, u);
+                pq.push(v, nd);
+                st.push(pq.size());
+            }
+        }
+    }
+    if (bestTarget) *bestTarget = bestNode;
+    return best;
+}
+
+/* ================================
+   StraightLineHeuristic : goal  Ÿ  
+   - scale : Ÿ   ȯ (ð ̸ 1 / ְ ӵ)
+   - fast  : equirectangular ٻ (goal  cos , 0.99    )
+   ================================ */
+struct StraightLineHeuristic {
+    StraightLineHeuristic(const Graph& g, uint32_t goal, double scale = 1.0, bool fast = true)
+        : g(g), scale(scale), fast(fast), glat(g.lat[goal]), glon(g.lon[goal]) {
+        constexpr double DEG = 3.14159265358979323846 / 180.0;
+        kx = DEG * std::cos(glat * DEG) * EARTH_R * scale * 0.99;
+        ky = DEG * EARTH_R * scale * 0.99;
+    }
+
+    double operator()(uint32_t u) const {
+        if (!fast) return haversine(g.lat[u], g.lon[u], glat, glon) * scale;
+        double x = (g.lon[u] - glon) * kx;
+        double y = (g.lat[u] - glat) * ky;
+        return std::sqrt(x * x + y * y);
+    }
+
+    const Graph& g;
+    double scale;
+    bool fast;
+    double glat, glon;
+    double kx = 0, ky = 0;
+};
+
+/* =========================================================
+   A* ִ  (start  goal)
+   - h(u) : goal     (admissible + consistent)
+   - ť key = dist + h,  dijkstra()  
+   ========================================================= */
+template <class Queue, class Stats, class Cost, class Heuristic>
+double astar(const Graph& g, BasicSearchWorkspace<Queue, Stats>& ws, uint32_t start, uint32_t goal,
+             Cost&& cost, Heuristic&& h) {
+    if (ws.size() != g.numNodes()) ws.resize(g.numNodes());
+    ws.reset();
+
+    auto& pq = ws.queue;
+    auto& st = ws.stats;
+    st.query();
+    ws.set(start, 0, INVALID_NODE);
+    pq.push(start, h(start));
+    st.push(pq.size());
+
+    while (!pq.empty()) {
+        auto [key, u] = pq.pop();
+        double cd = ws.dist(u);
+        if (key > cd + h(u)) { st.stale(); continue; }
+        st.settle();
+        if (u == goal) break;
+
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+            uint32_t v = g.target[e];
+            double nd = cd + cost(u, e);
+            st.relax();
+            if (ws.dist(v) > nd) {
+                ws.set(v, nd, u);
+                pq.push(v, nd + h(v));
+                st.push(pq.size());
+            }
+        }
+    }
+    return ws.dist(goal);
+}
+
+//  ()  A*
+template <class Queue, class Stats>
+double astar(const Graph& g, BasicSearchWorkspace<Queue, Stats>& ws, uint32_t start, uint32_t goal) {
+    return astar(g, ws, start, goal, [&g](uint32_t, uint32_t e) { return g.length[e]; },
+                 StraightLineHeuristic(g, goal));
+}
+
+/* ================================
+   BidirectionalWorkspace :  +  ۾   
+   - meet : ִ ΰ  
+   -  ⺰ (fwd.stats / bwd.stats)
+   ================================ */
+template <class Queue, class Stats = NoStats>
+struct BasicBidirectionalWorkspace {
+    BasicSearchWorkspace<Queue, Stats> fwd, bwd;
+    uint32_t meet = INVALID_NODE;
+
+    // start  meet (fwd.prev) + meet  goal (bwd.prev =  )
+    void path(std::vector<uint32_t>& out) const {
+        out.clear();
+        if (meet == INVALID_NODE) return;
+        fwd.path(meet, out);
+        for (uint32_t cur = bwd.prev(meet); cur != INVALID_NODE; cur = bwd.prev(cur)) out.push_back(cur);
+    }
+};
+
+using BidirectionalWorkspace = BasicBidirectionalWorkspace<QuadHeap>;
+using InstrumentedBidirectionalWorkspace = BasicBidirectionalWorkspace<QuadHeap, SearchStats>;
+
+struct ZeroPotential {
+    double operator()(uint32_t) const { return 0.0; }
+};
+
+/* =========================================================
+    Dijkstra / A* (start  goal)
+   -  target/offset,  rSource/rOffset   Ž
+   - pf / pb :  /  potential, pf(v) + pb(v)       0 ̸ Dijkstra
+   -   : top_f + top_b >= best + (pf + pb)
+   ========================================================= */
+template <class Queue, class Stats, class Cost, class PotentialF, class PotentialB>
+double bidirectionalSearch(const Graph& g, BasicBidirectionalWorkspace<Queue, Stats>& ws,
+                           uint32_t start, uint32_t goal, Cost&& cost, PotentialF&& pf, PotentialB&& pb) {
+    auto& F = ws.fwd;
+    auto& B = ws.bwd;
+    if (F.size() != g.numNodes()) F.resize(g.numNodes());
+    if (B.size() != g.numNodes()) B.resize(g.numNodes());
+    F.reset();
+    B.reset();
+
+    double best = INF_DIST;
+    ws.meet = INVALID_NODE;
+    if (start == goal) {
+        F.set(start, 0, INVALID_NODE);
+        B.set(goal, 0, INVALID_NODE);
+        ws.meet = start;
+        return 0;
+    }
+
+    F.stats.query();
+    B.stats.query();
+    F.set(start, 0, INVALID_NODE);
+    F.queue.push(start, pf(start));
+    F.stats.push(F.queue.size());
+    B.set(goal, 0, INVALID_NODE);
+    B.queue.push(goal, pb(goal));
+    B.stats.push(B.queue.size());
+    double sum = pf(start) + pb(start);
+
+    // lazy ť stale Ҹ Ⱦ  top key Ȯ
+    auto topKey = [](auto& W, auto&& pot) {
+        while (!W.queue.empty()) {
+            auto [k, u] = W.queue.top();
+            if (k <= W.dist(u) + pot(u)) return k;
+            W.queue.pop();
+            W.stats.stale();
+        }
+        return INF_DIST;
+    };
+    for (;;) {
+        double kf = topKey(F, pf);
+        double kb = topKey(B, pb);
+        if (kf >= INF_DIST && kb >= INF_DIST) break;
+        if (kf + kb >= best + sum) break;
+
+        if (kf <= kb) {
+            uint32_t u = F.queue.pop().second;
+            double du = F.dist(u);
+            F.stats.settle();
+            for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+                uint32_t v = g.target[e];
+                double nd = du + cost(u, e);
+                F.stats.relax();
+                if (F.dist(v) > nd) {
+                    F.set(v, nd, u);
+                    F.queue.push(v, nd + pf(v));
+                    F.stats.push(F.queue.size());
+                }
+                if (B.reached(v) && nd + B.dist(v) < best) {
+                    best = nd + B.dist(v);
+                    ws.meet = v;
+                }
+            }
+        } else {
+            uint32_t v = B.queue.pop().second;
+            double dv = B.dist(v);
+            B.stats.settle();
+            for (uint32_t k = g.inBegin(v); k < g.inEnd(v); k++) {
+                uint32_t u = g.rSource[k];
+                double nd = dv + cost(u, g.rEdge[k]);
+                B.stats.relax();
+                if (B.dist(u) > nd) {
+                    B.set(u, nd, v);
+                    B.queue.push(u, nd + pb(u));
+                    B.stats.push(B.queue.size());
+                }
+                if (F.reached(u) && nd + F.dist(u) < best) {
+                    best = nd + F.dist(u);
+                    ws.meet = u;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+//  ()   Dijkstra
+template <class Queue, class Stats>
+double bidirectionalDijkstra(const Graph& g, BasicBidirectionalWorkspace<Queue, Stats>& ws, uint32_t start, uint32_t goal) {
+    return bidirectionalSearch(g, ws, start, goal, [&g](uint32_t, uint32_t e) { return g.length[e]; },
+                               ZeroPotential(), ZeroPotential());
+}
+
+/* =========================================================
+    A*   potential
+   - pf = (h_goal - h_start) / 2 + h_start(goal) / 2
+   - pb = (h_start - h_goal) / 2 + h_goal(start) / 2
+   -  ﰢε potential  0 ̻  (RadixHeap )
+   ========================================================= */
+template <class Queue, class Stats>
+double bidirectionalAstar(const Graph& g, BasicBidirectionalWorkspace<Queue, Stats>& ws, uint32_t start, uint32_t goal) {
+    StraightLineHeuristic ht(g, goal), hs(g, start);
+    double cf = 0.5 * hs(goal), cb = 0.5 * ht(start);
+    return bidirectionalSearch(g, ws, start, goal, [&g](uint32_t, uint32_t e) { return g.length[e]; },
+                               [&](uint32_t v) { return 0.5 * (ht(v) - hs(v)) + cf; },
+                               [&](uint32_t v) { return 0.5 * (hs(v) - ht(v)) + cb; });
+}
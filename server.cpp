@@ -0,0 +1,522 @@
+/*
+ server.cpp :   Ž  (HTTP/JSON)
+   : server [--graph .graphml] [--port 8080] [--threads N] [--queue 1024] [--batch 64]
+                  [--connections 256] [--cache-mb 64]
+   --graph       : GraphML (  mmap), ⺻ jongro.graphml,     ε
+   --threads     :  Ž   (⺻ hardware_concurrency)
+   --queue       :  û ѵ, ġ ٷ 503 (backpressure)
+   --batch       :    ó ִ û 
+   --connections :   ѵ, ġ 503   
+   --cache-mb    :  ĳ ũ (0 ̸ ĳ )
+  û
+   GET /route?from=37.570,126.975&to=37.605,127.018[&path=0]
+        {"distance_m":..,"from":{"node":"id","snap_m":..},"to":{..},"path":["id",..]}
+   GET /health   {"status":"ok","nodes":..,"edges":..}
+   GET /metrics  û///ĳ ī (Prometheus ؽƮ )
+  ó ܰ ( ܰ ڱ  ۾ Ǯ 񵿱 )
+     : HTTP Ľ  û ť (  503),  8 KB   413, recv/send 10  
+   Ž  : ť ִ batch   ǥ    ()  BatchRouter  Dijkstra
+     : JSON ȭ ()   忡 Ϸ  (  Ž ļ )
+*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "graph.h"
+#include "snapshot.h"
+#include "spatial.h"
+#include "batch.h"
+#include "cache.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+using socket_t = SOCKET;
+static void closeSocket(socket_t s) { closesocket(s); }
+static const int SEND_FLAGS = 0;
+// /۽  ð (Winsock  DWORD и)
+static void setTimeouts(socket_t s, int sec) {
+    DWORD ms = (DWORD)sec * 1000;
+    setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, (const char*)&ms, sizeof(ms));
+    setsockopt(s, SOL_SOCKET, SO_SNDTIMEO, (const char*)&ms, sizeof(ms));
+}
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using socket_t = int;
+static const socket_t INVALID_SOCKET = -1;
+static void closeSocket(socket_t s) { ::close(s); }
+static void setTimeouts(socket_t s, int sec) {
+    timeval tv{ sec, 0 };
+    setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(s, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+#ifdef MSG_NOSIGNAL
+static const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+static const int SEND_FLAGS = 0;
+#endif
+#endif
+
+using namespace std;
+
+/* =====================  ===================== */
+const double SNAP_RADIUS = 200.0;  // ǥ     Ÿ (m)
+const size_t MAX_HEADER = 16384;   // û  ִ ũ
+const size_t MAX_BODY = 8192;      // û  ִ ũ (GET  óϹǷ  а ),  413
+const int IO_TIMEOUT_SEC = 10;     // Ằ recv / send  ð ( Ŭ̾Ʈ 带  ϰ)
+
+/* ================================
+   Job : û ϳ ܰ踦 ġ ä 
+   ================================ */
+struct Job {
+    double slat = 0, slon = 0, dlat = 0, dlon = 0;
+    bool withPath = true;
+
+    //  / Ž 
+    uint32_t start = INVALID_NODE, goal = INVALID_NODE;
+    double snapStart = 0, snapGoal = 0;
+    double cost = INF_DIST;
+    vector<uint32_t> path;
+
+    // 
+    int status = 200;
+    string body;
+    promise<void> done;
+};
+
+/* ================================
+   BoundedQueue : ѵ ִ ۾ ť
+   - tryPush :   false (ȣڰ ٷ )
+   - push    : ڸ   ٸ (ܰ  backpressure)
+   - popBatch : ϳ ̻   ٸ  ִ max  
+   ================================ */
+template <class T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(capacity) {}
+
+    bool tryPush(T v) {
+        {
+            lock_guard<mutex> lock(m);
+            if (items.size() >= capacity) return false;
+            items.push_back(move(v));
+        }
+        cv.notify_one();
+        return true;
+    }
+
+    void push(T v) {
+        {
+            unique_lock<mutex> lock(m);
+            notFull.wait(lock, [this] { return items.size() < capacity; });
+            items.push_back(move(v));
+        }
+        cv.notify_one();
+    }
+
+    void popBatch(vector<T>& out, size_t max) {
+        out.clear();
+        unique_lock<mutex> lock(m);
+        cv.wait(lock, [this] { return !items.empty(); });
+        while (!items.empty() && out.size() < max) {
+            out.push_back(move(items.front()));
+            items.pop_front();
+        }
+        lock.unlock();
+        notFull.notify_all();
+    }
+
+    size_t size() const {
+        lock_guard<mutex> lock(m);
+        return items.size();
+    }
+
+private:
+    size_t capacity;
+    mutable mutex m;
+    condition_variable cv, notFull;
+    deque<T> items;
+};
+
+/* ================================
+    ī (/metrics)
+   ================================ */
+struct ServerCounters {
+    atomic<uint64_t> requests{ 0 }, rejected{ 0 }, batches{ 0 }, batched{ 0 }, noRoute{ 0 }, badRequest{ 0 };
+    atomic<uint32_t> connections{ 0 };
+};
+
+/* =========================================================
+   RoutingService : ׷ /  / ۾ Ǯ     ܰ  û ó
+   ========================================================= */
+class RoutingService {
+public:
+    RoutingService(const Graph& g, unsigned threads, size_t queueLimit, size_t batch, size_t cacheBytes)
+        : g(g), router(g, threads), snapPool(max(1u, router.threads() / 2)), outPool(max(1u, router.threads() / 2)),
+          requests(queueLimit), finished(batch * 2), batch(batch) {
+        spatial.build(g);
+        if (cacheBytes) {
+            cache = make_unique<RouteCache>(cacheBytes);
+            router.useCache(cache.get(), 0); // ׷/ ̶ epoch  0 ϳ
+        }
+        routeThread = thread([this] { routeLoop(); });
+        outputThread = thread([this] { outputLoop(); });
+        routeThread.detach();
+        outputThread.detach();
+    }
+
+    // ť   false (ȣڰ 503 )
+    bool submit(Job* job) { return requests.tryPush(job); }
+
+    ServerCounters counters;
+
+    string metrics() const {
+        ostringstream out;
+        out << "server_requests_total " << counters.requests << "\n"
+            << "server_rejected_total " << counters.rejected << "\n"
+            << "server_bad_requests_total " << counters.badRequest << "\n"
+            << "server_no_route_total " << counters.noRoute << "\n"
+            << "server_batches_total " << counters.batches << "\n"
+            << "server_batched_requests_total " << counters.batched << "\n"
+            << "server_queue_depth " << requests.size() << "\n"
+            << "server_connections " << counters.connections << "\n";
+        if (cache) exportCounters(out, cache->counters(), "server");
+        return out.str();
+    }
+
+    const Graph& graph() const { return g; }
+
+private:
+    // 1)  +  Ž
+    void routeLoop() {
+        vector<Job*> jobs;
+        vector<RouteRequest> reqs;
+        vector<RouteResult> results;
+        vector<size_t> slot;
+        for (;;) {
+            requests.popBatch(jobs, batch);
+            counters.batches++;
+            counters.batched += jobs.size();
+
+            snapPool.parallelFor(jobs.size(), [&](unsigned, size_t i) {
+                Job& j = *jobs[i];
+                j.start = spatial.nearest(j.slat, j.slon, SNAP_RADIUS, &j.snapStart);
+                j.goal = spatial.nearest(j.dlat, j.dlon, SNAP_RADIUS, &j.snapGoal);
+            }, 8);
+
+            reqs.clear();
+            slot.clear();
+            for (size_t i = 0; i < jobs.size(); i++) {
+                if (jobs[i]->start == INVALID_NODE || jobs[i]->goal == INVALID_NODE) continue;
+                reqs.push_back({ jobs[i]->start, jobs[i]->goal });
+                slot.push_back(i);
+            }
+            router.dijkstra(reqs, results);
+
+            //  Ǯ   ٽ Ƿ  ܰ ѱ  
+            for (size_t k = 0; k < reqs.size(); k++) {
+                Job& j = *jobs[slot[k]];
+                j.cost = results[k].cost;
+                Span<uint32_t> p = router.path(results[k]);
+                if (j.withPath) j.path.assign(p.begin(), p.end());
+            }
+            for (Job* j : jobs) finished.push(j); //  и ⼭ ٸ  û ť  503
+        }
+    }
+
+    // 2) JSON ȭ + Ϸ 
+    void outputLoop() {
+        vector<Job*> jobs;
+        for (;;) {
+            finished.popBatch(jobs, batch);
+            outPool.parallelFor(jobs.size(), [&](unsigned, size_t i) { serialise(*jobs[i]); }, 8);
+            for (Job* j : jobs) j->done.set_value();
+        }
+    }
+
+    void serialise(Job& j) {
+        char num[64];
+        string& b = j.body;
+        if (j.start == INVALID_NODE || j.goal == INVALID_NODE) {
+            j.status = 422;
+            counters.badRequest++;
+            b = string("{\"error\":\"no intersection within 200 m of ") + (j.start == INVALID_NODE ? "from" : "to") + "\"}";
+            return;
+        }
+        if (j.cost >= INF_DIST) {
+            j.status = 404;
+            counters.noRoute++;
+            b = "{\"error\":\"no route\"}";
+            return;
+        }
+        b.reserve(128 + j.path.size() * 14);
+        snprintf(num, sizeof(num), "{\"distance_m\":%.3f,", j.cost);
+        b += num;
+        b += "\"from\":{\"node\":";
+        appendJsonString(b, g.id(j.start));
+        snprintf(num, sizeof(num), ",\"snap_m\":%.1f},\"to\":{\"node\":", j.snapStart);
+        b += num;
+        appendJsonString(b, g.id(j.goal));
+        snprintf(num, sizeof(num), ",\"snap_m\":%.1f}", j.snapGoal);
+        b += num;
+        if (j.withPath) {
+            b += ",\"path\":[";
+            for (size_t i = 0; i < j.path.size(); i++) {
+                if (i) b += ',';
+                appendJsonString(b, g.id(j.path[i]));
+            }
+            b += ']';
+        }
+        b += '}';
+    }
+
+    static void appendJsonString(string& out, string_view s) {
+        out += '"';
+        for (char c : s) {
+            if (c == '"' || c == '\\') { out += '\\'; out += c; }
+            else if ((unsigned char)c < 0x20) {
+                char esc[8];
+                snprintf(esc, sizeof(esc), "\\u%04x", (unsigned char)c);
+                out += esc;
+            } else out += c;
+        }
+        out += '"';
+    }
+
+    const Graph& g;
+    SpatialIndex spatial;
+    BatchRouter router;
+    ThreadPool snapPool, outPool;
+    unique_ptr<RouteCache> cache;
+    BoundedQueue<Job*> requests, finished;
+    size_t batch;
+    thread routeThread, outputThread;
+};
+
+/* =========================================================
+   HTTP : û  /  ڿ Ľ,   (keep-alive)
+   ========================================================= */
+static string urlDecode(string_view s) {
+    string out;
+    for (size_t i = 0; i < s.size(); i++) {
+        if (s[i] == '%' && i + 2 < s.size()) {
+            out += (char)strtol(string(s.substr(i + 1, 2)).c_str(), nullptr, 16);
+            i += 2;
+        } else out += s[i] == '+' ? ' ' : s[i];
+    }
+    return out;
+}
+
+static bool queryParam(string_view query, string_view key, string& value) {
+    while (!query.empty()) {
+        size_t amp = query.find('&');
+        string_view kv = query.substr(0, amp);
+        size_t eq = kv.find('=');
+        if (kv.substr(0, eq) == key) {
+            value = eq == string_view::npos ? string() : urlDecode(kv.substr(eq + 1));
+            return true;
+        }
+        if (amp == string_view::npos) break;
+        query.remove_prefix(amp + 1);
+    }
+    return false;
+}
+
+// "37.570,126.975"  (lat, lon)
+static bool parseLatLon(const string& v, double& lat, double& lon) {
+    char* end;
+    lat = strtod(v.c_str(), &end);
+    if (*end != ',') return false;
+    lon = strtod(end + 1, &end);
+    return *end == 0 && lat >= -90 && lat <= 90 && lon >= -180 && lon <= 180;
+}
+
+static bool sendAll(socket_t s, const string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        int k = (int)send(s, data.data() + sent, (int)(data.size() - sent), SEND_FLAGS);
+        if (k <= 0) return false;
+        sent += (size_t)k;
+    }
+    return true;
+}
+
+static bool respond(socket_t s, int status, const string& type, const string& body, bool keepAlive) {
+    const char* reason = status == 200 ? "OK" : status == 400 ? "Bad Request" : status == 404 ? "Not Found"
+        : status == 405 ? "Method Not Allowed" : status == 413 ? "Payload Too Large" : status == 422 ? "Unprocessable Entity" : "Service Unavailable";
+    string head = "HTTP/1.1 " + to_string(status) + " " + reason + "\r\nContent-Type: " + type
+        + "\r\nContent-Length: " + to_string(body.size()) + (keepAlive ? "\r\nConnection: keep-alive" : "\r\nConnection: close")
+        + "\r\n\r\n";
+    return sendAll(s, head + body);
+}
+
+static void serveConnection(socket_t s, RoutingService& service) {
+    string buf;
+    char chunk[4096];
+    for (;;) {
+        //   б (  Ƿ Content-Length ŭ ǳʶ)
+        size_t end;
+        while ((end = buf.find("\r\n\r\n")) == string::npos) {
+            if (buf.size() > MAX_HEADER) return;
+            int k = (int)recv(s, chunk, sizeof(chunk), 0);
+            if (k <= 0) return;
+            buf.append(chunk, (size_t)k);
+        }
+        string head = buf.substr(0, end);
+        buf.erase(0, end + 4);
+
+        string lower = head;
+        transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        bool keepAlive = lower.find("connection: close") == string::npos && lower.find("http/1.0") == string::npos;
+        size_t cl = lower.find("content-length:");
+        size_t bodyLen = cl == string::npos ? 0 : (size_t)strtoull(lower.c_str() + cl + 15, nullptr, 10);
+        if (bodyLen > MAX_BODY) {
+            respond(s, 413, "application/json", "{\"error\":\"request body too large\"}", false);
+            return;
+        }
+        while (buf.size() < bodyLen) {
+            int k = (int)recv(s, chunk, sizeof(chunk), 0);
+            if (k <= 0) return;
+            buf.append(chunk, (size_t)k);
+        }
+        buf.erase(0, bodyLen);
+
+        // û  : METHOD target HTTP/x.y
+        size_t sp1 = head.find(' '), sp2 = head.find(' ', sp1 + 1);
+        if (sp1 == string::npos || sp2 == string::npos) {
+            respond(s, 400, "application/json", "{\"error\":\"bad request line\"}", false);
+            return;
+        }
+        string method = head.substr(0, sp1), target = head.substr(sp1 + 1, sp2 - sp1 - 1);
+        size_t q = target.find('?');
+        string path = target.substr(0, q);
+        string_view query = q == string::npos ? string_view() : string_view(target).substr(q + 1);
+
+        bool ok;
+        if (method != "GET") {
+            ok = respond(s, 405, "application/json", "{\"error\":\"only GET is supported\"}", keepAlive);
+        } else if (path == "/health") {
+            const Graph& g = service.graph();
+            ok = respond(s, 200, "application/json", "{\"status\":\"ok\",\"nodes\":" + to_string(g.numNodes())
+                + ",\"edges\":" + to_string(g.numEdges()) + "}", keepAlive);
+        } else if (path == "/metrics") {
+            ok = respond(s, 200, "text/plain; version=0.0.4", service.metrics(), keepAlive);
+        } else if (path == "/route") {
+            service.counters.requests++;
+            Job job;
+            string from, to, withPath;
+            if (!queryParam(query, "from", from) || !queryParam(query, "to", to)
+                || !parseLatLon(from, job.slat, job.slon) || !parseLatLon(to, job.dlat, job.dlon)) {
+                service.counters.badRequest++;
+                ok = respond(s, 400, "application/json", "{\"error\":\"expected from=lat,lon&to=lat,lon\"}", keepAlive);
+            } else {
+                job.withPath = !(queryParam(query, "path", withPath) && withPath == "0");
+                auto done = job.done.get_future();
+                if (!service.submit(&job)) {
+                    service.counters.rejected++;
+                    ok = respond(s, 503, "application/json", "{\"error\":\"server busy\"}", keepAlive);
+                } else {
+                    done.wait();
+                    ok = respond(s, job.status, "application/json", job.body, keepAlive);
+                }
+            }
+        } else {
+            ok = respond(s, 404, "application/json", "{\"error\":\"unknown path\"}", keepAlive);
+        }
+        if (!ok || !keepAlive) return;
+    }
+}
+
+int main(int argc, char** argv) {
+    string file = "jongro.graphml";
+    int port = 8080;
+    unsigned threads = 0;
+    size_t queueLimit = 1024, batch = 64, maxConnections = 256, cacheMB = 64;
+    for (int i = 1; i < argc; i++) {
+        string a = argv[i];
+        auto next = [&]() { return i + 1 < argc ? string(argv[++i]) : string("0"); };
+        if (a == "--graph") file = next();
+        else if (a == "--port") port = stoi(next());
+        else if (a == "--threads") threads = (unsigned)stoul(next());
+        else if (a == "--queue") queueLimit = max<size_t>(1, stoul(next()));
+        else if (a == "--batch") batch = max<size_t>(1, stoul(next()));
+        else if (a == "--connections") maxConnections = max<size_t>(1, stoul(next()));
+        else if (a == "--cache-mb") cacheMB = stoul(next());
+        else {
+            cerr << " : server [--graph ] [--port 8080] [--threads N] [--queue 1024] [--batch 64]"
+                    " [--connections 256] [--cache-mb 64]\n";
+            return 1;
+        }
+    }
+
+#ifdef _WIN32
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) return 1;
+#else
+    signal(SIGPIPE, SIG_IGN);
+#endif
+
+    auto t0 = chrono::steady_clock::now();
+    Graph g;
+    if (!loadGraph(file, g)) {
+        cerr << "Graph load failed : " << file << "\n";
+        return 1;
+    }
+    RoutingService service(g, threads, queueLimit, batch, cacheMB << 20);
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    socket_t listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener == INVALID_SOCKET) return 1;
+    int yes = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, (const char*)&yes, sizeof(yes));
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port);
+    if (::bind(listener, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listener, 128) != 0) {
+        cerr << "Listen failed : port " << port << "\n";
+        return 1;
+    }
+    printf("nodes %u, edges %u, ready in %.1f ms, listening on :%d\n", g.numNodes(), g.numEdges(), ms, port);
+    fflush(stdout);
+
+    // Ḷ  ϳ (ѵ ʰ  ٷ 503)
+    for (;;) {
+        socket_t s = accept(listener, nullptr, nullptr);
+        if (s == INVALID_SOCKET) continue;
+        setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*)&yes, sizeof(yes));
+        setTimeouts(s, IO_TIMEOUT_SEC);
+        if (service.counters.connections >= maxConnections) {
+            service.counters.rejected++;
+            respond(s, 503, "application/json", "{\"error\":\"too many connections\"}", false);
+            closeSocket(s);
+            continue;
+        }
+        service.counters.connections++;
+        thread([s, &service] {
+            serveConnection(s, service);
+            closeSocket(s);
+            service.counters.connections--;
+        }).detach();
+    }
+}
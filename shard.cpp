@@ -0,0 +1,253 @@
+#include "shard.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "snapshot.h"
+
+using namespace std;
+
+/* =========================================================
+   searchAll : root   ü (ǥ  Dijkstra)
+   - reverse      dist(v) = v  root 
+   ========================================================= */
+static void searchAll(const Graph& g, SearchWorkspace& ws, uint32_t root, bool reverse) {
+    if (ws.size() != g.numNodes()) ws.resize(g.numNodes());
+    ws.reset();
+    auto& pq = ws.queue;
+    ws.set(root, 0, INVALID_NODE);
+    pq.push(root, 0);
+    while (!pq.empty()) {
+        auto [cd, u] = pq.pop();
+        if (cd > ws.dist(u)) continue;
+        uint32_t begin = reverse ? g.inBegin(u) : g.edgeBegin(u);
+        uint32_t end = reverse ? g.inEnd(u) : g.edgeEnd(u);
+        for (uint32_t k = begin; k < end; k++) {
+            uint32_t v = reverse ? g.rSource[k] : g.target[k];
+            double nd = cd + g.length[reverse ? g.rEdge[k] : k];
+            if (ws.dist(v) > nd) {
+                ws.set(v, nd, u);
+                pq.push(v, nd);
+            }
+        }
+    }
+}
+
+/* =========================================================
+   ShardRouter : ü ׷  c      
+   -  ȣ ü ȣ  (globalId ̺ Ž ȯ)
+   ========================================================= */
+ShardRouter::ShardRouter(const Graph& g, const Partition& p, uint32_t cell, Span<double> weight) : cell_(cell) {
+    for (uint32_t u = 0; u < g.numNodes(); u++)
+        if (p.cell[u] == cell) globalId.push_back(u);
+
+    GraphBuilder b;
+    for (uint32_t u : globalId) b.addNode(g.id(u), g.lat[u], g.lon[u]);
+    for (uint32_t i = 0; i < globalId.size(); i++) {
+        uint32_t u = globalId[i];
+        if (p.boundary[u]) {
+            boundary_.push_back(u);
+            boundaryLocal.push_back(i);
+        }
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+            uint32_t v = g.target[e];
+            if (p.cell[v] != cell || weight[e] >= INF_DIST) continue;
+            b.addEdge(i, localOf(v), weight[e], g.roadName(e), g.attr.oneway[e], g.attr.wayId[e], g.attr.highway[e]);
+        }
+    }
+    local = b.build();
+}
+
+uint32_t ShardRouter::localOf(uint32_t node) const {
+    auto it = lower_bound(globalId.begin(), globalId.end(), node);
+    return it != globalId.end() && *it == node ? (uint32_t)(it - globalId.begin()) : INVALID_NODE;
+}
+
+size_t ShardRouter::memoryBytes() const {
+    size_t n = local.numNodes(), m = local.numEdges();
+    return n * (2 * sizeof(double) + 4 * sizeof(uint32_t)) + local.idChars.size()
+        + m * (sizeof(double) + 4 * sizeof(uint32_t) + sizeof(uint64_t) + 2)
+        + local.attr.roadChars.size() + globalId.size() * sizeof(uint32_t) + boundary_.size() * 2 * sizeof(uint32_t);
+}
+
+void ShardRouter::boundaryClique(vector<double>& out) {
+    size_t b = boundaryLocal.size();
+    out.assign(b * b, INF_DIST);
+    for (size_t i = 0; i < b; i++) {
+        searchAll(local, ws, boundaryLocal[i], false);
+        for (size_t j = 0; j < b; j++) out[i * b + j] = ws.dist(boundaryLocal[j]);
+    }
+}
+
+void ShardRouter::toBoundary(uint32_t s, vector<double>& out) {
+    out.assign(boundaryLocal.size(), INF_DIST);
+    uint32_t ls = localOf(s);
+    if (ls == INVALID_NODE) return;
+    searchAll(local, ws, ls, false);
+    for (size_t i = 0; i < boundaryLocal.size(); i++) out[i] = ws.dist(boundaryLocal[i]);
+}
+
+void ShardRouter::fromBoundary(uint32_t t, vector<double>& out) {
+    out.assign(boundaryLocal.size(), INF_DIST);
+    uint32_t lt = localOf(t);
+    if (lt == INVALID_NODE) return;
+    searchAll(local, ws, lt, true);
+    for (size_t i = 0; i < boundaryLocal.size(); i++) out[i] = ws.dist(boundaryLocal[i]);
+}
+
+double ShardRouter::path(uint32_t s, uint32_t t, vector<uint32_t>* out) {
+    if (out) out->clear();
+    uint32_t ls = localOf(s), lt = localOf(t);
+    if (ls == INVALID_NODE || lt == INVALID_NODE) return INF_DIST;
+    double d = dijkstra(local, ws, ls, lt);
+    if (out && d < INF_DIST) {
+        ws.path(lt, *out);
+        for (uint32_t& u : *out) u = globalId[u];
+    }
+    return d;
+}
+
+/* -----------------------------------------
+    / б :  + "SHD1" Ÿ (,  ,  , ü ȣ,  ȣ)
+   ----------------------------------------- */
+static const char SHARD_MAGIC[4] = { 'S', 'H', 'D', '1' };
+
+bool ShardRouter::save(const string& file) const {
+    if (!writeSnapshot(local, file)) return false;
+    ofstream f(file + ".meta", ios::binary);
+    uint32_t hdr[3] = { cell_, (uint32_t)globalId.size(), (uint32_t)boundary_.size() };
+    f.write(SHARD_MAGIC, 4);
+    f.write(reinterpret_cast<const char*>(hdr), sizeof(hdr));
+    f.write(reinterpret_cast<const char*>(globalId.data()), globalId.size() * sizeof(uint32_t));
+    f.write(reinterpret_cast<const char*>(boundary_.data()), boundary_.size() * sizeof(uint32_t));
+    return (bool)f;
+}
+
+bool ShardRouter::load(const string& file) {
+    ifstream f(file + ".meta", ios::binary);
+    char magic[4];
+    uint32_t hdr[3];
+    f.read(magic, 4);
+    f.read(reinterpret_cast<char*>(hdr), sizeof(hdr));
+    if (!f || !equal(magic, magic + 4, SHARD_MAGIC)) return false;
+    globalId.resize(hdr[1]);
+    boundary_.resize(hdr[2]);
+    f.read(reinterpret_cast<char*>(globalId.data()), globalId.size() * sizeof(uint32_t));
+    f.read(reinterpret_cast<char*>(boundary_.data()), boundary_.size() * sizeof(uint32_t));
+    if (!f || !mapSnapshot(file, local) || local.numNodes() != hdr[1]) return false;
+    cell_ = hdr[0];
+    boundaryLocal.clear();
+    for (uint32_t u : boundary_) boundaryLocal.push_back(localOf(u));
+    return true;
+}
+
+vector<CutEdge> cutEdges(const Graph& g, const Partition& p, Span<double> weight) {
+    vector<CutEdge> out;
+    out.reserve(p.cutEdges.size());
+    for (uint32_t u = 0; u < g.numNodes(); u++)
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++)
+            if (p.cell[u] != p.cell[g.target[e]] && weight[e] < INF_DIST) out.push_back({ u, g.target[e], weight[e] });
+    return out;
+}
+
+/* =========================================================
+   Coordinator : overlay =   ,  =  clique +  
+   - overlay  ü ȣ  (overlayGlobal ̺ Ž)
+   -      clique (  尡 Ǯ ), ٸ   ״
+   ========================================================= */
+Coordinator::Coordinator(const vector<ShardRouter*>& shardList, const vector<CutEdge>& cuts) {
+    for (ShardRouter* sh : shardList) {
+        if (sh->cell() >= shards.size()) shards.resize(sh->cell() + 1, nullptr);
+        shards[sh->cell()] = sh;
+    }
+    vector<pair<uint32_t, uint32_t>> nodes; // (ü ȣ, )
+    for (ShardRouter* sh : shardList)
+        for (uint32_t u : sh->boundary()) nodes.push_back({ u, sh->cell() });
+    sort(nodes.begin(), nodes.end());
+
+    GraphBuilder b;
+    for (auto& [u, c] : nodes) {
+        overlayGlobal.push_back(u);
+        overlayCell.push_back(c);
+        b.addNode(to_string(u), 0, 0);
+    }
+    vector<double> clique;
+    for (ShardRouter* sh : shardList) {
+        const vector<uint32_t>& bd = sh->boundary();
+        sh->boundaryClique(clique);
+        size_t k = bd.size();
+        for (size_t i = 0; i < k; i++)
+            for (size_t j = 0; j < k; j++)
+                if (i != j && clique[i * k + j] < INF_DIST)
+                    b.addEdge(overlayOf(bd[i]), overlayOf(bd[j]), clique[i * k + j], "");
+    }
+    for (auto& c : cuts) b.addEdge(overlayOf(c.from), overlayOf(c.to), c.cost, "");
+    overlay = b.build();
+}
+
+ShardRouter* Coordinator::shardOf(uint32_t node) const {
+    for (ShardRouter* sh : shards)
+        if (sh && sh->owns(node)) return sh;
+    return nullptr;
+}
+
+uint32_t Coordinator::overlayOf(uint32_t node) const {
+    auto it = lower_bound(overlayGlobal.begin(), overlayGlobal.end(), node);
+    return it != overlayGlobal.end() && *it == node ? (uint32_t)(it - overlayGlobal.begin()) : INVALID_NODE;
+}
+
+//     = part  ù   ġ    ̾ 
+void Coordinator::appendPath(vector<uint32_t>& out, const vector<uint32_t>& p) const {
+    size_t skip = !out.empty() && !p.empty() && out.back() == p.front() ? 1 : 0;
+    out.insert(out.end(), p.begin() + skip, p.end());
+}
+
+double Coordinator::route(uint32_t s, uint32_t t, vector<uint32_t>* path) {
+    if (path) path->clear();
+    ShardRouter* A = shardOf(s);
+    ShardRouter* B = shardOf(t);
+    if (!A || !B) return INF_DIST;
+
+    // 1)  ̸    ε ĺ
+    double direct = A == B ? A->path(s, t) : INF_DIST;
+
+    // 2)    ,     ( 尡 )
+    A->toBoundary(s, fromS);
+    B->fromBoundary(t, toT);
+    vector<RouteEndpoint> sources, targets;
+    for (size_t i = 0; i < fromS.size(); i++)
+        if (fromS[i] < INF_DIST) sources.push_back({ overlayOf(A->boundary()[i]), fromS[i] });
+    for (size_t i = 0; i < toT.size(); i++)
+        if (toT[i] < INF_DIST) targets.push_back({ overlayOf(B->boundary()[i]), toT[i] });
+
+    // 3) overlay   /   Dijkstra
+    uint32_t last = INVALID_NODE;
+    double via = INF_DIST;
+    if (!sources.empty() && !targets.empty())
+        via = dijkstraMulti(overlay, ws, sources, targets, [this](uint32_t, uint32_t e) { return overlay.length[e]; },
+                            &last);
+
+    if (direct <= via) {
+        if (path && direct < INF_DIST) A->path(s, t, path);
+        return direct;
+    }
+    if (!path) return via;
+
+    // 4)  Ǯ : s  ù  (A), overlay  clique     /   ״,    t (B)
+    vector<uint32_t> hops;
+    ws.path(last, hops);
+    A->path(s, overlayGlobal[hops[0]], &part);
+    appendPath(*path, part);
+    for (size_t i = 1; i < hops.size(); i++) {
+        uint32_t x = hops[i - 1], y = hops[i];
+        if (overlayCell[x] == overlayCell[y]) {
+            shards[overlayCell[x]]->path(overlayGlobal[x], overlayGlobal[y], &part);
+            appendPath(*path, part);
+        } else {
+            path->push_back(overlayGlobal[y]);
+        }
+    }
+    B->path(overlayGlobal[last], t, &part);
+    appendPath(*path, part);
+    return via;
+}
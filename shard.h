@@ -0,0 +1,89 @@
+/*
+ shard.h :    +  overlay  (޸ /    Ȯ)
+  - ShardRouter :  ϳ κ ׷  (ü ׷  ,   /ε)
+      boundaryClique() :      ִ    overlay 
+      toBoundary() / fromBoundary() :   ,    
+      path() :    (overlay   η Ǯ )
+  - Coordinator :   +  clique +      θ ̾ 
+      route(s, t) = min( ̸    ,    overlay Dijkstra   )
+  -  ȣ  ְ޴ Լ (μ  ״ û/ ޽)
+  -  ȣ  ü ׷ ȣ,    ѱ weight (    )
+  -  ϳ = Ž ۾  ϳ   忡 ȣ
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "graph.h"
+#include "partition.h"
+#include "search.h"
+
+class ShardRouter {
+public:
+    ShardRouter() = default;
+    ShardRouter(const Graph& g, const Partition& p, uint32_t cell, Span<double> weight);
+
+    uint32_t cell() const { return cell_; }
+    const std::vector<uint32_t>& boundary() const { return boundary_; } // ü ȣ, 
+    bool owns(uint32_t node) const { return localOf(node) != INVALID_NODE; }
+    uint32_t numNodes() const { return local.numNodes(); }
+    size_t memoryBytes() const;
+
+    //   i  j   , b x b  켱 ( Ұ INF_DIST)
+    void boundaryClique(std::vector<double>& out);
+    // s  boundary()[i] / boundary()[i]  t   
+    void toBoundary(uint32_t s, std::vector<double>& out);
+    void fromBoundary(uint32_t t, std::vector<double>& out);
+
+    //   ִ  (ü ȣ),  Ұ INF_DIST   
+    double path(uint32_t s, uint32_t t, std::vector<uint32_t>* out = nullptr);
+
+    // κ ׷ (file),  ȣ / ü ȣ /   file + ".meta"
+    bool save(const std::string& file) const;
+    bool load(const std::string& file);
+
+private:
+    uint32_t localOf(uint32_t node) const;
+
+    Graph local;                        //   / (length = )
+    std::vector<uint32_t> globalId;     //  ȣ  ü ȣ ()
+    std::vector<uint32_t> boundary_;    //   ü ȣ
+    std::vector<uint32_t> boundaryLocal;
+    uint32_t cell_ = 0;
+    SearchWorkspace ws;
+};
+
+//    ( overlay , ü ȣ)
+struct CutEdge {
+    uint32_t from, to;
+    double cost;
+};
+
+std::vector<CutEdge> cutEdges(const Graph& g, const Partition& p, Span<double> weight);
+
+class Coordinator {
+public:
+    // shards[c] :  c   (ڴ ͸ ,   clique    ޾ )
+    Coordinator(const std::vector<ShardRouter*>& shards, const std::vector<CutEdge>& cuts);
+
+    //  ( Ұ INF_DIST), path  ָ ü ȣ 
+    double route(uint32_t s, uint32_t t, std::vector<uint32_t>* path = nullptr);
+
+    uint32_t overlayNodes() const { return overlay.numNodes(); }
+    uint32_t overlayEdges() const { return overlay.numEdges(); }
+
+private:
+    ShardRouter* shardOf(uint32_t node) const;
+    uint32_t overlayOf(uint32_t node) const;
+    void appendPath(std::vector<uint32_t>& out, const std::vector<uint32_t>& part) const;
+
+    std::vector<ShardRouter*> shards;
+    Graph overlay;                      //   (ü ȣ ) + clique /  
+    std::vector<uint32_t> overlayGlobal;
+    std::vector<uint32_t> overlayCell;
+    SearchWorkspace ws;
+    std::vector<double> fromS, toT;
+    std::vector<uint32_t> part;
+};
@@ -12,327 +12,266 @@
 #include <unordered_map>
 #include <vector>
 #include <string>
-#include <queue>
 #include <limits>
-#include <random>
 #include <algorithm>
 #include <iomanip>
 #include <chrono>
 #include <cmath>
-map<string, double> trafficLightDelay;
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-#include "tinyxml2.h"
+#include "graph.h"
+#include "search.h"
+#include "ch.h"
+#include "snapshot.h"
+#include "spatial.h"
+#include "snap.h"
+#include "sampler.h"
+#include "delay.h"
+#include "directions.h"
+#include "alternatives.h"
 
-using namespace tinyxml2;
 using namespace std;
 
-/* ================================
-   Node :   ׷ 
-   - id :  ȣ
-   - lat/lon : /浵
-   ================================ */
-struct Node {
-    string id;
-    double lat = 0.0;
-    double lon = 0.0;
-};
-
-/* ================================
-   EdgeInfo :  
-   - length : Ÿ ()
-   - roadName : θ
-   ================================ */
-struct EdgeInfo {
-    double length = 0.0;
-    string roadName;
-};
-
 /* ================================
     ׷ 
    ================================ */
-unordered_map<string, Node> nodes;                               //  
-unordered_map<string, vector<pair<string, double>>> adj;          // Ʈ: id  (̿, )
-unordered_map<string, unordered_map<string, EdgeInfo>> edgeInfoMap; //   
-unordered_map<string, string> keyIdToName;                        // GraphML key id  field name (d4 = lat )
-
-static constexpr double R = 6371000.0; //  ()
+Graph graph;                              // CSR ׷ (//θ)
+SearchWorkspace workspace;                //   Ǵ Ž 
+BidirectionalWorkspace biWorkspace;       //  Ž 
+CHGraph hierarchy;                        // Contraction Hierarchies ó 
+SpatialIndex spatial;                     // ǥ    
+DelayTable trafficLightDelay;             //  ȣ  ȣ  ð (ź 迭)
 
 /* =========================================================
-   Haversine Ÿ  (lat/lon  meter)
+   GraphML  ε (ȯ    mmap)
    ========================================================= */
-double haversine(double lat1, double lon1, double lat2, double lon2) {
-    auto rad = [](double d) { return d * M_PI / 180.0; };
-    double dlat = rad(lat2 - lat1), dlon = rad(lon2 - lon1);
-    double a = sin(dlat / 2) * sin(dlat / 2)
-        + cos(rad(lat1)) * cos(rad(lat2)) * sin(dlon / 2) * sin(dlon / 2);
-    return 2 * R * atan2(sqrt(a), sqrt(1 - a));
+bool loadGraphML(const string& file) {
+    if (!loadGraph(file, graph)) return false;
+    spatial.build(graph);
+    spatial.buildEdges(graph);
+    trafficLightDelay.reset(graph);
+    return true;
 }
 
 /* =========================================================
-   XML ± ̸ namespace  (node, edge  )
+    Է (lat, lon)    ã
+   -  Ÿ : 20m
    ========================================================= */
-string localName(const char* name) {
-    if (!name) return "";
-    string s = name;
-    size_t p = s.find_last_of(":}");
-    return (p != string::npos) ? s.substr(p + 1) : s;
+uint32_t findNode(double lat, double lon) {
+    return spatial.nearest(lat, lon, 20.0);
 }
 
 /* =========================================================
-   GraphML  ε
-   - d4 = latitude
-   - d5 = longitude
-   - d16 = length
-   - d13 = road name
+      :       ( Ÿ 50m)
+   - ο 20m Ѱ   ߰ ǥ Ī
+   - snapNode() :   ˰,     
    ========================================================= */
-bool loadGraphML(const string& file) {
-    XMLDocument doc;
-    if (doc.LoadFile(file.c_str()) != XML_SUCCESS) return false;
-    XMLElement* root = doc.RootElement();
-    if (!root) return false;
-
-    // 1) <key> ± о keyIdToName 
-    for (auto* key = root->FirstChildElement(); key; key = key->NextSiblingElement()) {
-        if (localName(key->Name()) != "key") continue;
-        const char* id = key->Attribute("id");
-        const char* attr = key->Attribute("attr.name");
-        if (id && attr) keyIdToName[id] = attr;
-    }
-
-    // 2) <graph> ± ã
-    XMLElement* graph = nullptr;
-    for (auto* c = root->FirstChildElement(); c; c = c->NextSiblingElement()) {
-        if (localName(c->Name()) == "graph") graph = c;
-    }
-    if (!graph) graph = root; // fallback
+EdgeSnap snapRoad(double lat, double lon) {
+    return spatial.snapEdge(lat, lon, 50.0);
+}
 
-    // 3)  Ľ
-    for (auto* n = graph->FirstChildElement(); n; n = n->NextSiblingElement()) {
-        if (localName(n->Name()) != "node") continue;
+uint32_t snapNode(const EdgeSnap& s) {
+    return s.t < 0.5 ? s.source : s.target;
+}
 
-        const char* id = n->Attribute("id");
-        if (!id) continue;
+/* =========================================================
+       ִ  ( ߰ /, κ  )
+   ========================================================= */
+double snappedDijkstra(const EdgeSnap& from, const EdgeSnap& to, vector<uint32_t>& path) {
+    return snappedRoute(graph, workspace, from, to, path);
+}
 
-        Node nd; nd.id = id;
+/* =========================================================
+      ( Ʈ  ü Ÿ)
+   ========================================================= */
+double pathLength(const vector<uint32_t>& p) {
+    return pathLength(graph, p);
+}
 
-        for (auto* d = n->FirstChildElement(); d; d = d->NextSiblingElement()) {
-            if (localName(d->Name()) != "data") continue;
-            const char* key = d->Attribute("key");
-            const char* text = d->GetText();
-            if (!key || !text) continue;
+/* =========================================================
+     : Ÿ +   ȣ 
+   ========================================================= */
+double roadCost(uint32_t, uint32_t e) {
+    return graph.length[e] + trafficLightDelay(graph, e);
+}
 
-            string attr = keyIdToName[key];
-            double v = atof(text);
+//   (Ÿ + ȣ  )
+double pathCost(const vector<uint32_t>& p) {
+    return pathLength(graph, p) + trafficLightDelay.along(graph, p);
+}
 
-            if (attr == "lat" || attr == "y" || key == string("d4"))
-                nd.lat = v;
-            else if (attr == "lon" || attr == "x" || key == string("d5"))
-                nd.lon = v;
-        }
-        nodes[id] = nd;
-        adj[id]; //  Ʈ ʱȭ
-    }
+/* =========================================================
+   Dijkstra ִ  ˰
+   ========================================================= */
+vector<uint32_t> dijkstra(uint32_t start, uint32_t goal) {
+    vector<uint32_t> path;
+    if (dijkstra(graph, workspace, start, goal, roadCost) >= INF_DIST) return path; //   Ұ
 
-    // 4)  Ľ
-    for (auto* e = graph->FirstChildElement(); e; e = e->NextSiblingElement()) {
-        if (localName(e->Name()) != "edge") continue;
-
-        const char* s = e->Attribute("source");
-        const char* t = e->Attribute("target");
-        if (!s || !t) continue;
-
-        double length = NAN;
-        string road;
-        string oneway;
-
-        //  data Ľ
-        for (auto* d = e->FirstChildElement(); d; d = d->NextSiblingElement()) {
-            if (localName(d->Name()) != "data") continue;
-
-            const char* key = d->Attribute("key");
-            const char* text = d->GetText();
-            if (!key || !text) continue;
-
-            string attr = keyIdToName[key];
-
-            if (attr == "length" || key == string("d16"))
-                length = atof(text);
-            else if (attr == "name" || key == string("d13"))
-                road = text;
-            else if (attr == "oneway")
-                oneway = text;
-        }
-
-        // 4-1)   浵  
-        if (!isfinite(length)) {
-            if (nodes.count(s) && nodes.count(t))
-                length = haversine(nodes[s].lat, nodes[s].lon, nodes[t].lat, nodes[t].lon);
-            else length = 0.0;
-        }
-
-        // 4-2) ⼺ ó (oneway true ܹ)
-        bool isOne = false;
-        if (!oneway.empty()) {
-            string v = oneway;
-            transform(v.begin(), v.end(), v.begin(), ::tolower);
-            if (v == "true" || v == "yes" || v == "1") isOne = true;
-        }
-
-        // Ʈ   
-        adj[s].push_back({ t, length });
-        edgeInfoMap[s][t] = { length, road };
-
-        if (!isOne) {
-            adj[t].push_back({ s, length });
-            edgeInfoMap[t][s] = { length, road };
-        }
-    }
-    return true;
+    workspace.path(goal, path);
+    return path;
 }
 
 /* =========================================================
-    Է (lat, lon)    ã
-   -  Ÿ : 20m
+   A* ִ  (Ÿ ޸ƽ)
    ========================================================= */
-string findNode(double lat, double lon) {
-    string best = "";
-    double minD = 1e18;
-
-    for (auto& kv : nodes) {
-        const Node& n = kv.second;
-        double d = haversine(lat, lon, n.lat, n.lon);
-        if (d < minD) { minD = d; best = n.id; }
-    }
-    return (minD <= 20.0) ? best : "";
+vector<uint32_t> astar(uint32_t start, uint32_t goal) {
+    vector<uint32_t> path;
+    StraightLineHeuristic h(graph, goal); // ȣ  0 ̻̹Ƿ Ÿ  
+    if (astar(graph, workspace, start, goal, roadCost, h) >= INF_DIST) return path;
+
+    workspace.path(goal, path);
+    return path;
 }
 
 /* =========================================================
-      ( Ʈ  ü Ÿ)
+    Dijkstra (Ϲ  ׷ ó)
    ========================================================= */
-double pathLength(const vector<string>& p) {
-    double sum = 0;
-    for (size_t i = 1; i < p.size(); i++)
-        sum += edgeInfoMap[p[i - 1]][p[i]].length;
-    return sum;
+vector<uint32_t> bidirectional(uint32_t start, uint32_t goal) {
+    vector<uint32_t> path;
+    if (bidirectionalSearch(graph, biWorkspace, start, goal, roadCost, ZeroPotential(), ZeroPotential()) >= INF_DIST)
+        return path;
+
+    biWorkspace.path(path);
+    return path;
 }
 
 /* =========================================================
-   Dijkstra ִ  ˰
+   CH غ :    ׷ ̸ а (/  + ), ƴϸ ó  
+   - ȣ Ⱑ ԷµǸ  ޶Ƿ   ʰ  ó
    ========================================================= */
-vector<string> dijkstra(const string& start, const string& goal) {
-    unordered_map<string, double> dist;
-    unordered_map<string, string> prev;
-
-    // Ÿ ʱȭ
-    for (auto& kv : nodes) dist[kv.first] = 1e18;
-    dist[start] = 0;
-
-    // ּ 
-    priority_queue<pair<double, string>,
-        vector<pair<double, string>>,
-        greater<>> pq;
-
-    pq.push({ 0, start });
-
-    while (!pq.empty()) {
-        auto [cd, u] = pq.top();
-        pq.pop();
-
-        if (u == goal) break;
-
-        for (auto& pr : adj[u]) {
-            string v = pr.first;
-            double w = pr.second;
-            double lightDelay = 0;
-            if (trafficLightDelay.count(v)) {
-                lightDelay = trafficLightDelay[v];
-            }
-            if (dist[v] > cd + w) {
-                dist[v] = cd + w;
-                prev[v] = u;
-                pq.push({ dist[v], v });
-            }
-        }
+void prepareCH(const string& file) {
+    if (!trafficLightDelay.empty()) {
+        vector<double> w(graph.numEdges());
+        for (uint32_t e = 0; e < graph.numEdges(); e++) w[e] = roadCost(0, e);
+        hierarchy = buildCH(graph, w);
+        return;
     }
+    if (loadCH(hierarchy, file, graph, graph.length)) return;
+    hierarchy = buildCH(graph, graph.length);
+    saveCH(hierarchy, file, graph, graph.length);
+}
 
-    //   Ұ
-    if (dist[goal] >= 1e18) return {};
+/* =========================================================
+   CH ִ  (shortcut   η Ǯ ȯ)
+   ========================================================= */
+vector<uint32_t> chRoute(uint32_t start, uint32_t goal) {
+    vector<uint32_t> path;
+    if (chQuery(hierarchy, biWorkspace, start, goal) >= INF_DIST) return path;
 
-    //  
-    vector<string> path;
-    for (string cur = goal; ; cur = prev[cur]) {
-        path.push_back(cur);
-        if (cur == start) break;
-    }
-    reverse(path.begin(), path.end());
+    chPath(hierarchy, biWorkspace, path);
     return path;
 }
 
+/* =========================================================
+     (via-node / plateau) : ִ ο  ٸ  ִ k 
+   ========================================================= */
+vector<AlternativeRoute> alternatives(uint32_t start, uint32_t goal, unsigned k) {
+    vector<double> w(graph.numEdges());
+    for (uint32_t e = 0; e < graph.numEdges(); e++) w[e] = roadCost(0, e);
+    AlternativeWorkspace ws;
+    AlternativeOptions opt;
+    opt.k = k;
+    vector<AlternativeRoute> routes;
+    alternativeRoutes(graph, ws, start, goal, w, opt, routes);
+    return routes;
+}
+
 /* =========================================================
    Monte Carlo Random Path Sampling
    -   (  Ž)
    - Dijkstra ˰   
+   - ȱ   ,  seed    (sampler.h)
    ========================================================= */
-vector<string> monteCarlo(const string& start, const string& goal, int M, int N) {
-    //   õ
-    mt19937_64 rng(
-        chrono::high_resolution_clock::now().time_since_epoch().count()
-    );
-
-    vector<string> best;
-    int bestStep = 1e9;
-    double bestLen = 1e18;
-
-    // M ݺ 
-    for (int i = 0; i < M; i++) {
-        vector<string> path = { start };
-        string cur = start;
-
-        // N ܱ  Ž
-        for (int st = 0; st < N; st++) {
-            if (cur == goal) break;
-            auto& nb = adj[cur];
-            if (nb.empty()) break;
-
-            uniform_int_distribution<int> pick(0, nb.size() - 1);
-            string nxt = nb[pick(rng)].first;
-
-            path.push_back(nxt);
-            cur = nxt;
-        }
-
-        //     ĺ Ʈ
-        if (cur == goal) {
-            double len = pathLength(path);
-            if ((int)path.size() < bestStep ||
-                ((int)path.size() == bestStep && len < bestLen)) {
-                bestStep = path.size();
-                bestLen = len;
-                best = path;
-            }
-        }
+vector<uint32_t> monteCarlo(uint32_t start, uint32_t goal, int M, int N) {
+    WalkOptions opt;
+    opt.walks = M;
+    opt.maxSteps = N;
+    opt.seed = chrono::high_resolution_clock::now().time_since_epoch().count(); // ึ ٸ ǥ
+    return randomWalkSample(graph, start, goal, opt).path;
+}
+
+/* =========================================================
+     (--stats) :  Ǹ  ۾  ٽ  ī 
+   -  Ǵ NoStats ۾ ̶   
+   - ܰ : snap (ǥ  /), search, unpack ( )
+   ========================================================= */
+void printStats(double slat, double slon, double dlat, double dlon, uint32_t start, uint32_t goal) {
+    const string prefix = "mobility_route";
+    SearchStats snap;
+    {
+        PhaseTimer t(snap.snapUs);
+        findNode(slat, slon);
+        findNode(dlat, dlon);
+        snapRoad(slat, slon);
+        snapRoad(dlat, dlon);
     }
-    return best;
+    exportCounters(cout, snap, prefix, "algo=\"snap\"");
+
+    vector<uint32_t> path;
+    InstrumentedWorkspace ws(graph.numNodes());
+    {
+        PhaseTimer t(ws.stats.searchUs);
+        dijkstra(graph, ws, start, goal, roadCost);
+    }
+    {
+        PhaseTimer t(ws.stats.unpackUs);
+        ws.path(goal, path);
+    }
+    exportCounters(cout, ws.stats, prefix, "algo=\"dijkstra\"");
+
+    ws.stats.clear();
+    {
+        PhaseTimer t(ws.stats.searchUs);
+        astar(graph, ws, start, goal, roadCost, StraightLineHeuristic(graph, goal));
+    }
+    {
+        PhaseTimer t(ws.stats.unpackUs);
+        ws.path(goal, path);
+    }
+    exportCounters(cout, ws.stats, prefix, "algo=\"astar\"");
+
+    InstrumentedBidirectionalWorkspace bw;
+    double searchUs = 0, unpackUs = 0;
+    {
+        PhaseTimer t(searchUs);
+        bidirectionalSearch(graph, bw, start, goal, roadCost, ZeroPotential(), ZeroPotential());
+    }
+    {
+        PhaseTimer t(unpackUs);
+        bw.path(path);
+    }
+    SearchStats bi = bw.fwd.stats;
+    bi.merge(bw.bwd.stats);
+    bi.queries = bw.fwd.stats.queries;
+    bi.searchUs = searchUs;
+    bi.unpackUs = unpackUs;
+    exportCounters(cout, bi, prefix, "algo=\"bidirectional\"");
+
+    SearchStats mc;
+    WalkResult r;
+    {
+        PhaseTimer t(mc.searchUs);
+        WalkOptions opt;
+        r = randomWalkSample(graph, start, goal, opt);
+    }
+    mc.queries = 1;
+    mc.walks = WalkOptions().walks;
+    mc.walksAbandoned = mc.walks - r.reached;
+    mc.walkSteps = r.walkedSteps;
+    exportCounters(cout, mc, prefix, "algo=\"monte_carlo\"");
 }
 
 /* =========================================================
    ¿ :  path  "a-b-c-d" ڿ
    ========================================================= */
-string toDash(const vector<string>& p) {
-    string s;
-    for (size_t i = 0; i < p.size(); i++) {
-        s += p[i];
-        if (i + 1 < p.size()) s += "-";
-    }
-    return s;
+string toDash(const vector<uint32_t>& p) {
+    return toDash(graph, p);
 }
 
 /* =========================================================
    Main
+   - --stats :  ڿ Ǻ Ž ī  (Prometheus ؽƮ )
    ========================================================= */
-int main() {
+int main(int argc, char** argv) {
+    bool withStats = argc > 1 && string(argv[1]) == "--stats";
     string file = "jongro.graphml";
 
     if (!loadGraphML(file)) {
@@ -347,11 +286,15 @@ int main() {
     cout << "Insert destination position. ";
     cin >> dlat >> dlon;
 
-    //  Ī
-    string s = findNode(slat, slon);
-    string d = findNode(dlat, dlon);
+    //  Ī (20m ȿ ΰ      )
+    EdgeSnap ss = snapRoad(slat, slon);
+    EdgeSnap ds = snapRoad(dlat, dlon);
+    uint32_t s = findNode(slat, slon);
+    uint32_t d = findNode(dlat, dlon);
+    if (s == INVALID_NODE && ss.valid()) s = snapNode(ss);
+    if (d == INVALID_NODE && ds.valid()) d = snapNode(ds);
 
-    if (s.empty() || d.empty()) {
+    if (s == INVALID_NODE || d == INVALID_NODE) {
         cout << "Node not found\n";
         return 0;
     }
@@ -364,7 +307,8 @@ int main() {
         double delay;
         cout << " ID ȣ ð Է: ";
         cin >> node >> delay;
-        trafficLightDelay[node] = delay;
+        uint32_t u = graph.find(node);
+        if (u != INVALID_NODE) trafficLightDelay.setNode(u, delay);
     }
     // Monte Carlo Ž (M=2000, N=1000)
     auto mc = monteCarlo(s, d, 2000, 1000);
@@ -372,7 +316,28 @@ int main() {
 
     // Dijkstra ִܰ
     auto dj = dijkstra(s, d);
-    double djLen = dj.empty() ? -1 : pathLength(dj);
+    double djLen = dj.empty() ? -1 : pathCost(dj);
+
+    // A* ִܰ
+    auto as = astar(s, d);
+    double asLen = as.empty() ? -1 : pathLength(as);
+
+    //  Dijkstra
+    auto bd = bidirectional(s, d);
+    double bdLen = bd.empty() ? -1 : pathLength(bd);
+
+    // Contraction Hierarchies
+    prepareCH("jongro.ch");
+    auto hc = chRoute(s, d);
+    double hcLen = hc.empty() ? -1 : pathLength(hc);
+
+    //   (ִ   3 )
+    auto alts = alternatives(s, d, 3);
+
+    //     (ΰ ƴ  /)
+    vector<uint32_t> sr;
+    double srLen = (ss.valid() && ds.valid()) ? snappedDijkstra(ss, ds, sr) : -1;
+    if (srLen >= INF_DIST) srLen = -1;
 
     // 
     cout << fixed << setprecision(6);
@@ -380,6 +345,26 @@ int main() {
     cout << "[Random Sampling] Vehicle route: " << toDash(mc) << "\n";
     cout << "[Dijkstra] Total distance + traffic delay (sec): " << djLen << "\n";
     cout << "[Dijkstra] Vehicle route: " << toDash(dj) << "\n";
+    cout << "[A*] Path distance (m): " << asLen << "\n";
+    cout << "[A*] Vehicle route: " << toDash(as) << "\n";
+    cout << "[Bidirectional] Path distance (m): " << bdLen << "\n";
+    cout << "[Bidirectional] Vehicle route: " << toDash(bd) << "\n";
+    cout << "[CH] Path distance (m): " << hcLen << "\n";
+    cout << "[CH] Vehicle route: " << toDash(hc) << "\n";
+    cout << "[Road snap] Path distance (m): " << srLen << "\n";
+    cout << "[Road snap] Vehicle route: " << toDash(sr) << "\n";
+    for (size_t i = 1; i < alts.size(); i++) {
+        cout << "[Alternative " << i << "] Total distance + traffic delay (sec): " << alts[i].cost
+             << " (shared " << alts[i].share * 100 << "%)\n";
+        cout << "[Alternative " << i << "] Vehicle route: " << toDash(alts[i].path) << "\n";
+    }
+
+    // Dijkstra  ȳ (θ / ȸ)
+    vector<RouteStep> steps;
+    describeRoute(graph, dj, steps);
+    for (const string& line : formatDirections(graph, steps)) cout << "[Directions] " << line << "\n";
+
+    if (withStats) printStats(slat, slon, dlat, dlon, s, d);
 
     return 0;
 }
@@ -0,0 +1,53 @@
+/*
+ snap.h :  (EdgeSnap)   / ϴ 
+  -  :   uv   t   v  (1-t) * cost,    u  t * cost
+  -  :     忡  κ 
+  -       θ  ٷ   
+*/
+#pragma once
+
+#include <vector>
+
+#include "graph.h"
+#include "search.h"
+#include "spatial.h"
+
+/* =========================================================
+   snappedRoute : from  to  ( Ұ INF_DIST)
+   - path :    (   ٷ   )
+   ========================================================= */
+template <class Queue, class Stats, class Cost>
+double snappedRoute(const Graph& g, BasicSearchWorkspace<Queue, Stats>& ws, const EdgeSnap& from, const EdgeSnap& to,
+                    Cost&& cost, std::vector<uint32_t>& path) {
+    path.clear();
+    if (!from.valid() || !to.valid()) return INF_DIST;
+
+    uint32_t fu = from.source, fv = from.target, fe = from.edge, fr = g.findEdge(fv, fu);
+    uint32_t tu = to.source, tv = to.target, te = to.edge, tr = g.findEdge(tv, tu);
+
+    std::vector<RouteEndpoint> sources, targets;
+    sources.push_back({ fv, (1 - from.t) * cost(fu, fe) });
+    if (fr != INVALID_EDGE) sources.push_back({ fu, from.t * cost(fv, fr) });
+    targets.push_back({ tu, to.t * cost(tu, te) });
+    if (tr != INVALID_EDGE) targets.push_back({ tv, (1 - to.t) * cost(tv, tr) });
+
+    //   :   ٷ ̵
+    double direct = INF_DIST;
+    if (fe == te) {
+        if (to.t >= from.t) direct = (to.t - from.t) * cost(fu, fe);
+        else if (fr != INVALID_EDGE) direct = (from.t - to.t) * cost(fv, fr);
+    }
+
+    uint32_t last = INVALID_NODE;
+    double best = dijkstraMulti(g, ws, sources, targets, cost, &last);
+    if (direct <= best) return direct;
+    ws.path(last, path);
+    return best;
+}
+
+//  () 
+template <class Queue, class Stats>
+double snappedRoute(const Graph& g, BasicSearchWorkspace<Queue, Stats>& ws, const EdgeSnap& from, const EdgeSnap& to,
+                    std::vector<uint32_t>& path) {
+    return snappedRoute(g, ws, from, to, [&g](uint32_t, uint32_t e) { return g.length[e]; }, path);
+}
@@ -0,0 +1,255 @@
+#include "snapshot.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/* =========================================================
+     (little-endian,   8Ʈ )
+   [SnapshotHeader] [ 0] [ 1] ...
+   ========================================================= */
+namespace {
+
+enum Section {
+    S_LAT, S_LON, S_ID_OFFSET, S_ID_CHARS, S_ID_SORTED,
+    S_OFFSET, S_TARGET, S_LENGTH, S_ROAD_ID, S_ONEWAY,
+    S_ROAD_OFFSET, S_ROAD_CHARS,
+    S_R_OFFSET, S_R_SOURCE, S_R_EDGE,
+    S_WAY_ID, S_HIGHWAY, S_INPUT_ID,
+    S_COUNT
+};
+
+const char MAGIC[8] = { 'M', 'O', 'B', 'G', 'R', 'A', 'P', 'H' };
+
+struct SectionInfo {
+    uint64_t offset;
+    uint64_t bytes;
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;      // bit0 = useLengthAttr, bit1 = honourOneway, bit2..3 = order
+    uint32_t numNodes;
+    uint32_t numEdges;
+    uint32_t sections;
+    uint32_t reserved;
+    uint64_t sourceBytes;  //  GraphML ũ (0 = )
+    int64_t sourceMtime;   //  GraphML  ð ()
+    SectionInfo section[S_COUNT];
+};
+
+uint32_t optionFlags(const GraphMLOptions& opt) {
+    return (opt.useLengthAttr ? 1u : 0u) | (opt.honourOneway ? 2u : 0u) | ((uint32_t)opt.order << 2);
+}
+
+/* -----------------------------------------
+   б   
+   ----------------------------------------- */
+struct MappedFile {
+    const char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+    bool open(const string& path) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER sz;
+        if (!GetFileSizeEx(file, &sz) || sz.QuadPart == 0) return false;
+        size = (size_t)sz.QuadPart;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) return false;
+        data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        return data != nullptr;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) { ::close(fd); return false; }
+        size = (size_t)st.st_size;
+        void* p = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+        data = (const char*)p;
+        return true;
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (data) munmap((void*)data, size);
+#endif
+    }
+};
+
+template <class T>
+void writeSection(ofstream& f, SnapshotHeader& h, Section s, const Array<T>& a) {
+    static const char pad[8] = {};
+    uint64_t pos = (uint64_t)f.tellp();
+    if (pos % 8) {
+        f.write(pad, 8 - pos % 8);
+        pos += 8 - pos % 8;
+    }
+    h.section[s].offset = pos;
+    h.section[s].bytes = a.size() * sizeof(T);
+    f.write(reinterpret_cast<const char*>(a.data()), a.size() * sizeof(T));
+}
+
+template <class T>
+bool viewSection(const MappedFile& mf, const SnapshotHeader& h, Section s, Array<T>& a, size_t expect) {
+    const SectionInfo& si = h.section[s];
+    if (si.offset % 8 || si.offset + si.bytes > mf.size || si.bytes % sizeof(T)) return false;
+    size_t n = (size_t)(si.bytes / sizeof(T));
+    if (expect != (size_t)-1 && n != expect) return false;
+    a.view(reinterpret_cast<const T*>(mf.data + si.offset), n);
+    return true;
+}
+
+} // namespace
+
+SourceStamp sourceStamp(const string& file) {
+#ifdef _WIN32
+    struct _stat64 st;
+    if (_stat64(file.c_str(), &st) != 0) return {};
+#else
+    struct stat st;
+    if (stat(file.c_str(), &st) != 0) return {};
+#endif
+    return { (uint64_t)st.st_size, (int64_t)st.st_mtime };
+}
+
+/* =========================================================
+     : ӽ Ͽ  ̸  (д μ     ʵ)
+   - POSIX rename     ٲ, Windows    
+   ========================================================= */
+bool writeSnapshot(const Graph& g, const string& file, const GraphMLOptions& opt, const SourceStamp& source) {
+    string tmp = file + ".tmp";
+    {
+        ofstream f(tmp, ios::binary);
+        if (!f) return false;
+
+        SnapshotHeader h;
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, MAGIC, sizeof(MAGIC));
+        h.version = SNAPSHOT_VERSION;
+        h.flags = optionFlags(opt);
+        h.numNodes = g.numNodes();
+        h.numEdges = g.numEdges();
+        h.sections = S_COUNT;
+        h.sourceBytes = source.bytes;
+        h.sourceMtime = source.mtime;
+        f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+
+        writeSection(f, h, S_LAT, g.lat);
+        writeSection(f, h, S_LON, g.lon);
+        writeSection(f, h, S_ID_OFFSET, g.idOffset);
+        writeSection(f, h, S_ID_CHARS, g.idChars);
+        writeSection(f, h, S_ID_SORTED, g.idSorted);
+        writeSection(f, h, S_OFFSET, g.offset);
+        writeSection(f, h, S_TARGET, g.target);
+        writeSection(f, h, S_LENGTH, g.length);
+        writeSection(f, h, S_ROAD_ID, g.attr.roadId);
+        writeSection(f, h, S_ONEWAY, g.attr.oneway);
+        writeSection(f, h, S_ROAD_OFFSET, g.attr.roadOffset);
+        writeSection(f, h, S_ROAD_CHARS, g.attr.roadChars);
+        writeSection(f, h, S_R_OFFSET, g.rOffset);
+        writeSection(f, h, S_R_SOURCE, g.rSource);
+        writeSection(f, h, S_R_EDGE, g.rEdge);
+        writeSection(f, h, S_WAY_ID, g.attr.wayId);
+        writeSection(f, h, S_HIGHWAY, g.attr.highway);
+        writeSection(f, h, S_INPUT_ID, g.inputId);
+
+        f.seekp(0);
+        f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        if (!f) return false;
+    }
+#ifdef _WIN32
+    remove(file.c_str());
+#endif
+    return rename(tmp.c_str(), file.c_str()) == 0;
+}
+
+/* =========================================================
+    mmap : / ũ ˻  Graph 迭   
+   ========================================================= */
+bool mapSnapshot(const string& file, Graph& g, const GraphMLOptions* opt, const SourceStamp* source) {
+    auto mf = make_shared<MappedFile>();
+    if (!mf->open(file) || mf->size < sizeof(SnapshotHeader)) return false;
+
+    SnapshotHeader h;
+    memcpy(&h, mf->data, sizeof(h));
+    if (memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 || h.version != SNAPSHOT_VERSION || h.sections != S_COUNT)
+        return false;
+    if (opt && h.flags != optionFlags(*opt)) return false;
+    if (source && (h.sourceBytes != source->bytes || h.sourceMtime != source->mtime)) return false;
+
+    const size_t ANY = (size_t)-1;
+    size_t n = h.numNodes, m = h.numEdges;
+    Graph r;
+    bool ok = viewSection(*mf, h, S_LAT, r.lat, n)
+        && viewSection(*mf, h, S_LON, r.lon, n)
+        && viewSection(*mf, h, S_ID_OFFSET, r.idOffset, n + 1)
+        && viewSection(*mf, h, S_ID_CHARS, r.idChars, ANY)
+        && viewSection(*mf, h, S_ID_SORTED, r.idSorted, n)
+        && viewSection(*mf, h, S_OFFSET, r.offset, n + 1)
+        && viewSection(*mf, h, S_TARGET, r.target, m)
+        && viewSection(*mf, h, S_LENGTH, r.length, m)
+        && viewSection(*mf, h, S_ROAD_ID, r.attr.roadId, m)
+        && viewSection(*mf, h, S_ONEWAY, r.attr.oneway, m)
+        && viewSection(*mf, h, S_ROAD_OFFSET, r.attr.roadOffset, ANY)
+        && viewSection(*mf, h, S_ROAD_CHARS, r.attr.roadChars, ANY)
+        && viewSection(*mf, h, S_R_OFFSET, r.rOffset, n + 1)
+        && viewSection(*mf, h, S_R_SOURCE, r.rSource, m)
+        && viewSection(*mf, h, S_R_EDGE, r.rEdge, m)
+        && viewSection(*mf, h, S_WAY_ID, r.attr.wayId, m)
+        && viewSection(*mf, h, S_HIGHWAY, r.attr.highway, m)
+        && viewSection(*mf, h, S_INPUT_ID, r.inputId, ANY);
+    if (!ok || (!r.inputId.empty() && r.inputId.size() != n) || r.offset[n] != m || r.idOffset[n] != r.idChars.size() || r.attr.roadOffset.empty()) return false;
+
+    r.storage = mf;
+    g = move(r);
+    return true;
+}
+
+string snapshotPath(const string& graphml, const GraphMLOptions& opt) {
+    string base = graphml;
+    size_t dot = base.find_last_of('.');
+    if (dot != string::npos && base.find_first_of("/\\", dot) == string::npos) base.resize(dot);
+    if (!opt.useLengthAttr) base += ".haversine";
+    if (!opt.honourOneway) base += ".twoway";
+    if (opt.order == ORDER_INPUT) base += ".input";
+    if (opt.order == ORDER_BFS) base += ".bfs";
+    return base + ".bin";
+}
+
+bool loadGraph(const string& graphml, Graph& g, const GraphMLOptions& opt) {
+    string bin = snapshotPath(graphml, opt);
+    SourceStamp src = sourceStamp(graphml);
+    if (mapSnapshot(bin, g, &opt, src.bytes ? &src : nullptr)) return true;
+    if (!loadGraphML(graphml, g, opt)) return false;
+    writeSnapshot(g, bin, opt, src);
+    return true;
+}
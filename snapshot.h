@@ -0,0 +1,39 @@
+/*
+ snapshot.h : ̳ʸ ׷  (mmap )
+  - GraphML    Ľؼ  CSR ׷  ִ ̳ʸ Ϸ 
+  - ǥ,  , θ, Ϲ ǥ, id ڿ ̺,  CSR 
+  -  ġ ȣ  (ε  ȣ inputId ,  ɼ flags  )
+  - mapSnapshot()   б  mmap ϰ Graph 迭   ٷ Ŵ
+      ð  ms,  ȣƮ  μ page cache  
+  -  GraphML  ũ /  ð    loadGraph()   ٲ ٽ Ľؼ 
+*/
+#pragma once
+
+#include <string>
+
+#include "graph.h"
+
+static constexpr uint32_t SNAPSHOT_VERSION = 4;
+
+//   ǥ (ũ 0 ̸   / Ȯ  )
+struct SourceStamp {
+    uint64_t bytes = 0;
+    int64_t mtime = 0;
+};
+SourceStamp sourceStamp(const std::string& file);
+
+bool writeSnapshot(const Graph& g, const std::string& file, const GraphMLOptions& opt = GraphMLOptions(),
+                   const SourceStamp& source = SourceStamp());
+
+// opt  ־    ε ɼǰ  Ȯ, source  ־  ǥõ Ȯ
+bool mapSnapshot(const std::string& file, Graph& g, const GraphMLOptions* opt = nullptr,
+                 const SourceStamp* source = nullptr);
+
+// GraphML  + ε ɼ    (: jongro.graphml  jongro.bin)
+std::string snapshotPath(const std::string& graphml, const GraphMLOptions& opt = GraphMLOptions());
+
+/* =========================================================
+   loadGraph :  ְ GraphML   ڷ ٲ ʾ mmap, ƴϸ GraphML Ľ   
+   - GraphML    ε ( Ȯ )
+   ========================================================= */
+bool loadGraph(const std::string& graphml, Graph& g, const GraphMLOptions& opt = GraphMLOptions());
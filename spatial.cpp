@@ -0,0 +1,323 @@
+#include "spatial.h"
+
+#include <algorithm>
+#include <cmath>
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+/* =========================================================
+    
+   ========================================================= */
+void SpatialIndex::build(const Graph& g, double cellMeters) {
+    uint32_t n = g.numNodes();
+    cellOffset.clear();
+    cellNode.clear();
+    nodeLat.clear();
+    nodeLon.clear();
+    if (n == 0) return;
+
+    double maxLat = g.lat[0], maxLon = g.lon[0];
+    minLat = g.lat[0];
+    minLon = g.lon[0];
+    for (uint32_t u = 1; u < n; u++) {
+        minLat = min(minLat, g.lat[u]);
+        maxLat = max(maxLat, g.lat[u]);
+        minLon = min(minLon, g.lon[u]);
+        maxLon = max(maxLon, g.lon[u]);
+    }
+
+    constexpr double DEG = M_PI / 180.0;
+    double mPerLat = EARTH_R * DEG;
+    // 浵 1 ̴ ϼ ª   ȿ  ª    
+    double cosMin = cos(min(89.0, max(fabs(minLat), fabs(maxLat))) * DEG);
+    double mPerLon = mPerLat * cosMin;
+
+    if (cellMeters <= 0) {
+        double w = max(1.0, (maxLon - minLon) * mPerLon), h = max(1.0, (maxLat - minLat) * mPerLat);
+        cellMeters = max(10.0, sqrt(w * h * 2.0 / n));
+    }
+    cellLat = cellMeters / mPerLat;
+    cellLon = cellMeters / mPerLon;
+    cols = (int)((maxLon - minLon) / cellLon) + 1;
+    rows = (int)((maxLat - minLat) / cellLat) + 1;
+
+    // ĭ     ġ  ʵ (а  )
+    while ((double)cols * rows > 4.0 * n + 16) {
+        cellLat *= 1.5;
+        cellLon *= 1.5;
+        cols = (int)((maxLon - minLon) / cellLon) + 1;
+        rows = (int)((maxLat - minLat) / cellLat) + 1;
+    }
+    // 浵  cosMin  Ƿ  Ÿ  ̻, 0.99  haversine   
+    ringMeters = 0.99 * min(cellLat * mPerLat, cellLon * mPerLon);
+
+    size_t cells = (size_t)cols * rows;
+    vector<uint32_t> cellOf(n);
+    cellOffset.assign(cells + 1, 0);
+    for (uint32_t u = 0; u < n; u++) {
+        cellOf[u] = (uint32_t)cellY(g.lat[u]) * cols + cellX(g.lon[u]);
+        cellOffset[cellOf[u] + 1]++;
+    }
+    for (size_t c = 0; c < cells; c++) cellOffset[c + 1] += cellOffset[c];
+
+    vector<uint32_t> pos(cellOffset.begin(), cellOffset.end() - 1);
+    cellNode.resize(n);
+    nodeLat.resize(n);
+    nodeLon.resize(n);
+    for (uint32_t u = 0; u < n; u++) {
+        uint32_t k = pos[cellOf[u]]++;
+        cellNode[k] = u;
+        nodeLat[k] = g.lat[u];
+        nodeLon[k] = g.lon[u];
+    }
+}
+
+int SpatialIndex::cellX(double lon) const {
+    int x = (int)floor((lon - minLon) / cellLon);
+    return min(max(x, 0), cols - 1);
+}
+
+int SpatialIndex::cellY(double lat) const {
+    int y = (int)floor((lat - minLat) / cellLat);
+    return min(max(y, 0), rows - 1);
+}
+
+template <class Fn>
+void SpatialIndex::forRing(int cx, int cy, int r, Fn&& fn) const {
+    int y0 = max(cy - r, 0), y1 = min(cy + r, rows - 1);
+    for (int y = y0; y <= y1; y++) {
+        bool edgeRow = (y == cy - r || y == cy + r);
+        int step = edgeRow ? 1 : 2 * r;
+        for (int x = cx - r; x <= cx + r; x += max(step, 1)) {
+            if (x < 0 || x >= cols) continue;
+            fn((uint32_t)y * cols + x);
+        }
+    }
+}
+
+/* =========================================================
+   
+   -  ĭ (cx, cy)    r  ĭ ִ  ּ (r-1) * ringMeters  
+   -   ̸ ڸ ĭ  ( Ÿ Ѻ  )
+   ========================================================= */
+uint32_t SpatialIndex::nearest(double lat, double lon, double maxDist, double* dist) const {
+    uint32_t best = INVALID_NODE;
+    double bestD = maxDist;
+    if (!empty()) {
+        int cx = cellX(lon), cy = cellY(lat);
+        int maxR = max(cols, rows);
+        for (int r = 0; r <= maxR; r++) {
+            if (r > 0 && (r - 1) * ringMeters > bestD) break;
+            forRing(cx, cy, r, [&](uint32_t c) {
+                for (uint32_t k = cellOffset[c]; k < cellOffset[c + 1]; k++) {
+                    double d = haversine(lat, lon, nodeLat[k], nodeLon[k]);
+                    if (d < bestD || (d == bestD && best == INVALID_NODE)) {
+                        bestD = d;
+                        best = cellNode[k];
+                    }
+                }
+            });
+        }
+    }
+    if (dist) *dist = best == INVALID_NODE ? 1e18 : bestD;
+    return best;
+}
+
+void SpatialIndex::kNearest(double lat, double lon, size_t k, vector<Neighbor>& out, double maxDist) const {
+    out.clear();
+    if (empty() || k == 0) return;
+
+    int cx = cellX(lon), cy = cellY(lat);
+    int maxR = max(cols, rows);
+    auto worse = [](const Neighbor& a, const Neighbor& b) { return a.dist < b.dist; };
+
+    // out  ִ (   ) 
+    for (int r = 0; r <= maxR; r++) {
+        double bound = (r - 1) * ringMeters;
+        double cut = out.size() == k ? out.front().dist : maxDist;
+        if (r > 0 && bound > cut) break;
+
+        forRing(cx, cy, r, [&](uint32_t c) {
+            for (uint32_t j = cellOffset[c]; j < cellOffset[c + 1]; j++) {
+                double d = haversine(lat, lon, nodeLat[j], nodeLon[j]);
+                if (d > maxDist) continue;
+                if (out.size() < k) {
+                    out.push_back({ cellNode[j], d });
+                    push_heap(out.begin(), out.end(), worse);
+                } else if (d < out.front().dist) {
+                    pop_heap(out.begin(), out.end(), worse);
+                    out.back() = { cellNode[j], d };
+                    push_heap(out.begin(), out.end(), worse);
+                }
+            }
+        });
+    }
+    sort_heap(out.begin(), out.end(), worse);
+}
+
+void SpatialIndex::withinRadius(double lat, double lon, double radius, vector<Neighbor>& out) const {
+    out.clear();
+    if (empty()) return;
+
+    int cx = cellX(lon), cy = cellY(lat);
+    int maxR = max(cols, rows);
+    for (int r = 0; r <= maxR; r++) {
+        if (r > 0 && (r - 1) * ringMeters > radius) break;
+        forRing(cx, cy, r, [&](uint32_t c) {
+            for (uint32_t k = cellOffset[c]; k < cellOffset[c + 1]; k++) {
+                double d = haversine(lat, lon, nodeLat[k], nodeLon[k]);
+                if (d <= radius) out.push_back({ cellNode[k], d });
+            }
+        });
+    }
+    sort(out.begin(), out.end(), [](const Neighbor& a, const Neighbor& b) { return a.dist < b.dist; });
+}
+
+/* =========================================================
+    
+   -  (uv, vu) u < v  ϳ 
+   -  bbox  ġ ĭ    r     (r-1) * ringMeters  
+   ========================================================= */
+void SpatialIndex::buildEdges(const Graph& g) {
+    segOffset.clear();
+    segEdge.clear();
+    segLat0.clear();
+    segLon0.clear();
+    segLat1.clear();
+    segLon1.clear();
+    edgeGraph = &g;
+    if (empty()) return;
+
+    size_t cells = (size_t)cols * rows;
+    vector<pair<uint32_t, uint32_t>> items; // (ĭ, )
+    for (uint32_t u = 0; u < g.numNodes(); u++) {
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+            uint32_t v = g.target[e];
+            if (u == v) continue;
+            if (u > v && g.findEdge(v, u) != INVALID_EDGE) continue;
+            if (g.findEdge(u, v) != e) continue; //    ª ͸
+            int x0 = cellX(min(g.lon[u], g.lon[v])), x1 = cellX(max(g.lon[u], g.lon[v]));
+            int y0 = cellY(min(g.lat[u], g.lat[v])), y1 = cellY(max(g.lat[u], g.lat[v]));
+            for (int y = y0; y <= y1; y++)
+                for (int x = x0; x <= x1; x++) items.push_back({ (uint32_t)y * cols + x, e });
+        }
+    }
+
+    vector<uint32_t> source(g.numEdges());
+    for (uint32_t u = 0; u < g.numNodes(); u++)
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) source[e] = u;
+
+    segOffset.assign(cells + 1, 0);
+    for (auto& it : items) segOffset[it.first + 1]++;
+    for (size_t c = 0; c < cells; c++) segOffset[c + 1] += segOffset[c];
+
+    size_t m = items.size();
+    segEdge.resize(m);
+    segLat0.resize(m);
+    segLon0.resize(m);
+    segLat1.resize(m);
+    segLon1.resize(m);
+    vector<uint32_t> pos(segOffset.begin(), segOffset.end() - 1);
+    for (auto& it : items) {
+        uint32_t k = pos[it.first]++;
+        uint32_t e = it.second, u = source[e], v = g.target[e];
+        segEdge[k] = e;
+        segLat0[k] = (float)(g.lat[u] - minLat);
+        segLon0[k] = (float)(g.lon[u] - minLon);
+        segLat1[k] = (float)(g.lat[v] - minLat);
+        segLon1[k] = (float)(g.lon[v] - minLon);
+    }
+}
+
+/* =========================================================
+       ( ó  ٻ,  : )
+   - ǥ ( - ) * (/)  ٲ    AB  
+   - d2[i] : Ÿ, t[i] : A   [0, 1]
+   ========================================================= */
+static void projectSegments(const float* lat0, const float* lon0, const float* lat1, const float* lon1, size_t n,
+                            float qLat, float qLon, float ky, float kx, float* d2, float* t) {
+    size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128 qy = _mm_set1_ps(qLat), qx = _mm_set1_ps(qLon);
+    const __m128 sy = _mm_set1_ps(ky), sx = _mm_set1_ps(kx);
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), tiny = _mm_set1_ps(1e-12f);
+    for (; i + 4 <= n; i += 4) {
+        __m128 ay = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(lat0 + i), qy), sy);
+        __m128 ax = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(lon0 + i), qx), sx);
+        __m128 dy = _mm_sub_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(lat1 + i), qy), sy), ay);
+        __m128 dx = _mm_sub_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(lon1 + i), qx), sx), ax);
+        __m128 len2 = _mm_max_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), tiny);
+        __m128 dot = _mm_add_ps(_mm_mul_ps(ax, dx), _mm_mul_ps(ay, dy));
+        __m128 tt = _mm_min_ps(_mm_max_ps(_mm_div_ps(_mm_sub_ps(zero, dot), len2), zero), one);
+        __m128 py = _mm_add_ps(ay, _mm_mul_ps(tt, dy));
+        __m128 px = _mm_add_ps(ax, _mm_mul_ps(tt, dx));
+        _mm_storeu_ps(d2 + i, _mm_add_ps(_mm_mul_ps(px, px), _mm_mul_ps(py, py)));
+        _mm_storeu_ps(t + i, tt);
+    }
+#endif
+    for (; i < n; i++) {
+        float ay = (lat0[i] - qLat) * ky, ax = (lon0[i] - qLon) * kx;
+        float dy = (lat1[i] - qLat) * ky - ay, dx = (lon1[i] - qLon) * kx - ax;
+        float len2 = max(dx * dx + dy * dy, 1e-12f);
+        float tt = min(max(-(ax * dx + ay * dy) / len2, 0.0f), 1.0f);
+        float py = ay + tt * dy, px = ax + tt * dx;
+        d2[i] = px * px + py * py;
+        t[i] = tt;
+    }
+}
+
+EdgeSnap SpatialIndex::snapEdge(double lat, double lon, double maxDist) const {
+    EdgeSnap best;
+    if (segEdge.empty()) return best;
+
+    constexpr double DEG = M_PI / 180.0;
+    float ky = (float)(EARTH_R * DEG), kx = (float)(EARTH_R * DEG * cos(lat * DEG));
+    float qLat = (float)(lat - minLat), qLon = (float)(lon - minLon);
+
+    float bestD2 = (float)min(maxDist * maxDist, 1e30);
+    uint32_t bestK = UINT32_MAX;
+    float bestT = 0;
+    float d2[64], t[64];
+
+    int cx = cellX(lon), cy = cellY(lat);
+    int maxR = max(cols, rows);
+    for (int r = 0; r <= maxR; r++) {
+        double bound = (r - 1) * ringMeters;
+        if (r > 0 && bound > 0 && bound * bound > bestD2) break;
+
+        forRing(cx, cy, r, [&](uint32_t c) {
+            for (uint32_t b = segOffset[c]; b < segOffset[c + 1]; b += 64) {
+                size_t n = min<size_t>(64, segOffset[c + 1] - b);
+                projectSegments(&segLat0[b], &segLon0[b], &segLat1[b], &segLon1[b], n, qLat, qLon, ky, kx, d2, t);
+                for (size_t i = 0; i < n; i++) {
+                    if (d2[i] < bestD2) {
+                        bestD2 = d2[i];
+                        bestK = b + (uint32_t)i;
+                        bestT = t[i];
+                    }
+                }
+            }
+        });
+    }
+    if (bestK == UINT32_MAX) return best;
+
+    best.edge = segEdge[bestK];
+    best.source = (uint32_t)(upper_bound(edgeGraph->offset.begin(), edgeGraph->offset.end(), best.edge) - edgeGraph->offset.begin() - 1);
+    best.target = edgeGraph->target[best.edge];
+    best.t = bestT;
+    best.dist = sqrt((double)bestD2);
+    best.lat = minLat + segLat0[bestK] + bestT * (segLat1[bestK] - segLat0[bestK]);
+    best.lon = minLon + segLon0[bestK] + bestT * (segLon1[bestK] - segLon0[bestK]);
+    return best;
+}
+
+void SpatialIndex::snapTrace(const vector<pair<double, double>>& trace, vector<EdgeSnap>& out, double maxDist) const {
+    out.resize(trace.size());
+    for (size_t i = 0; i < trace.size(); i++) out[i] = snapEdge(trace[i].first, trace[i].second, maxDist);
+}
@@ -0,0 +1,86 @@
+/*
+ spatial.h : ǥ  ()  
+  -  (uniform grid) : /浵   ũ ĭ  ĭ   CSR  
+  - nearest()      :    ( Ÿ ̳)
+  - kNearest()     :   k 
+  - withinRadius() : ݰ r()  ,  
+  Ÿ haversine  Ȯϰ, ĭ   Ž    Ǵ  us
+  - snapEdge()     :    п  (buildEdges()  )
+                     ĭ  ǥ SoA  ΰ SSE2  4  
+  - snapTrace()    : GPS    ο 
+*/
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+
+struct Neighbor {
+    uint32_t node;
+    double dist; // 
+};
+
+/* ================================
+   EdgeSnap :    
+   - edge :  (source  target),  δ  ⸸ εǹǷ  findEdge 
+   - t    :   ġ (0 = source, 1 = target)
+   ================================ */
+struct EdgeSnap {
+    uint32_t edge = INVALID_EDGE;
+    uint32_t source = INVALID_NODE, target = INVALID_NODE;
+    double t = 0;
+    double dist = 1e18; // 
+    double lat = 0, lon = 0;
+
+    bool valid() const { return edge != INVALID_EDGE; }
+};
+
+class SpatialIndex {
+public:
+    // cellMeters = 0 ̸ ĭ    2   ǵ ڵ 
+    void build(const Graph& g, double cellMeters = 0);
+
+    bool empty() const { return nodeLat.empty(); }
+
+    // maxDist ȿ 尡  INVALID_NODE
+    uint32_t nearest(double lat, double lon, double maxDist = 1e18, double* dist = nullptr) const;
+
+    void kNearest(double lat, double lon, size_t k, std::vector<Neighbor>& out, double maxDist = 1e18) const;
+
+    void withinRadius(double lat, double lon, double radius, std::vector<Neighbor>& out) const;
+
+    //    (build()   ,   bbox   ĭ )
+    void buildEdges(const Graph& g);
+
+    // maxDist ȿ ΰ  valid() == false
+    EdgeSnap snapEdge(double lat, double lon, double maxDist = 1e18) const;
+
+
+    void snapTrace(const std::vector<std::pair<double, double>>& trace, std::vector<EdgeSnap>& out,
+                   double maxDist = 1e18) const;
+
+private:
+    double minLat = 0, minLon = 0;
+    double cellLat = 1, cellLon = 1;   // ĭ ũ ()
+    double ringMeters = 0;              // ĭ ϳ ϴ ּ Ÿ ()
+    int cols = 0, rows = 0;
+
+    std::vector<uint32_t> cellOffset;   // ũ rows*cols+1
+    std::vector<uint32_t> cellNode;     // ĭ  ĵ  ȣ
+    std::vector<double> nodeLat, nodeLon; // cellNode    ǥ ( )
+
+    //  : ĭ  CSR,  ǥ (minLat, minLon)    float
+    const Graph* edgeGraph = nullptr; // buildEdges()  ѱ ׷
+    std::vector<uint32_t> segOffset;
+    std::vector<uint32_t> segEdge;
+    std::vector<float> segLat0, segLon0, segLat1, segLon1;
+
+    int cellX(double lon) const;
+    int cellY(double lat) const;
+
+    // (cx, cy)  ߽ Chebyshev Ÿ r  ĭ 湮 : fn(ĭ ȣ)
+    template <class Fn>
+    void forRing(int cx, int cy, int r, Fn&& fn) const;
+};
@@ -0,0 +1,108 @@
+/*
+ stats.h : Ž  å (Ǻ )
+  - NoStats     :    ζ Լ    ڵ尡   (⺻)
+  - SearchStats : settle / relax / push / stale pop / ִ ť ũ 
+  - ۾   ° ø ڷ  : BasicSearchWorkspace<QuadHeap, SearchStats>
+  - ܰ躰 ð (snap / search / unpack)  PhaseTimer  ȣϴ ʿ 
+  - exportCounters() : Prometheus ؽƮ  ī ("̸{} ")
+*/
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+struct NoStats {
+    static constexpr bool enabled = false;
+    void query() {}
+    void settle() {}
+    void relax() {}
+    void push(size_t) {}
+    void stale() {}
+};
+
+struct SearchStats {
+    static constexpr bool enabled = true;
+
+    uint64_t queries = 0;
+    uint64_t settled = 0;    // Ȯ( ó) 
+    uint64_t relaxed = 0;    // 캻 
+    uint64_t pushes = 0;     // ť  / key 
+    uint64_t stalePops = 0;  //  ̹  ª Ȯ  (lazy ť)
+    uint64_t peakQueue = 0;  // ť ִ ũ
+
+    // Monte Carlo ǥ (sampler.h  ȣϴ ʿ )
+    uint64_t walks = 0;
+    uint64_t walksAbandoned = 0; //   ϰ  ȱ (ġ, ٸ ,  ѵ)
+    uint64_t walkSteps = 0;
+
+    // ܰ躰 ð (us)
+    double snapUs = 0, searchUs = 0, unpackUs = 0;
+
+    void query() { queries++; }
+    void settle() { settled++; }
+    void relax() { relaxed++; }
+    void push(size_t queueSize) {
+        pushes++;
+        peakQueue = std::max<uint64_t>(peakQueue, queueSize);
+    }
+    void stale() { stalePops++; }
+
+    void clear() { *this = SearchStats(); }
+    void merge(const SearchStats& o) {
+        queries += o.queries;
+        settled += o.settled;
+        relaxed += o.relaxed;
+        pushes += o.pushes;
+        stalePops += o.stalePops;
+        peakQueue = std::max(peakQueue, o.peakQueue);
+        walks += o.walks;
+        walksAbandoned += o.walksAbandoned;
+        walkSteps += o.walkSteps;
+        snapUs += o.snapUs;
+        searchUs += o.searchUs;
+        unpackUs += o.unpackUs;
+    }
+};
+
+/* ================================
+   PhaseTimer :     ð(us) acc  
+   ================================ */
+class PhaseTimer {
+public:
+    explicit PhaseTimer(double& acc) : acc_(acc), t0_(std::chrono::steady_clock::now()) {}
+    ~PhaseTimer() {
+        acc_ += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0_).count();
+    }
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    double& acc_;
+    std::chrono::steady_clock::time_point t0_;
+};
+
+/* =========================================================
+   ī  : prefix_settled_total{labels} 123 
+   - labels ) algo="dijkstra"
+   ========================================================= */
+inline void exportCounters(std::ostream& out, const SearchStats& s, const std::string& prefix,
+                           const std::string& labels = "") {
+    std::string l = labels.empty() ? "" : "{" + labels + "}";
+    out << prefix << "_queries_total" << l << " " << s.queries << "\n"
+        << prefix << "_settled_total" << l << " " << s.settled << "\n"
+        << prefix << "_relaxed_total" << l << " " << s.relaxed << "\n"
+        << prefix << "_pushes_total" << l << " " << s.pushes << "\n"
+        << prefix << "_stale_pops_total" << l << " " << s.stalePops << "\n"
+        << prefix << "_peak_queue" << l << " " << s.peakQueue << "\n";
+    if (s.walks) {
+        out << prefix << "_walks_total" << l << " " << s.walks << "\n"
+            << prefix << "_walks_abandoned_total" << l << " " << s.walksAbandoned << "\n"
+            << prefix << "_walk_steps_total" << l << " " << s.walkSteps << "\n";
+    }
+    out << prefix << "_snap_seconds_total" << l << " " << s.snapUs / 1e6 << "\n"
+        << prefix << "_search_seconds_total" << l << " " << s.searchUs / 1e6 << "\n"
+        << prefix << "_unpack_seconds_total" << l << " " << s.unpackUs / 1e6 << "\n";
+}
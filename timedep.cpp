@@ -0,0 +1,72 @@
+#include "timedep.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+ProfilePool::ProfilePool(uint32_t slots) : slots_(max(slots, 1u)), scale(max(slots, 1u) / DAY_SECONDS) {
+    add(vector<float>(slots_, 1.0f));
+}
+
+uint32_t ProfilePool::add(const vector<float>& factors) {
+    vector<float> s(factors.begin(), factors.end());
+    s.resize(slots_, s.empty() ? 1.0f : s.back());
+    s.push_back(s[0]); // ֱ 
+
+    // FNV-1a ؽ   ؽ ϰ  
+    uint64_t hash = 1469598103934665603ull;
+    for (float v : s) {
+        uint32_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        hash = (hash ^ bits) * 1099511628211ull;
+    }
+    auto& same = byHash[hash];
+    for (uint32_t p : same) {
+        if (equal(s.begin(), s.end(), values.begin() + (size_t)p * (slots_ + 1))) return p;
+    }
+
+    uint32_t id = size();
+    values.insert(values.end(), s.begin(), s.end());
+    minimum.push_back(*min_element(s.begin(), s.end()));
+    same.push_back(id);
+    return id;
+}
+
+uint32_t ProfilePool::addPoints(const vector<pair<double, double>>& points) {
+    vector<float> s(slots_, 1.0f);
+    if (!points.empty()) {
+        vector<pair<double, double>> p(points);
+        sort(p.begin(), p.end());
+        // ֱ  :      ù 
+        p.push_back({ p.front().first + DAY_SECONDS, p.front().second });
+        p.insert(p.begin(), { p[p.size() - 2].first - DAY_SECONDS, p[p.size() - 2].second });
+        size_t k = 0;
+        for (uint32_t i = 0; i < slots_; i++) {
+            double t = i * DAY_SECONDS / slots_;
+            while (k + 2 < p.size() && p[k + 1].first <= t) k++;
+            double t0 = p[k].first, t1 = p[k + 1].first;
+            double f = t1 > t0 ? (t - t0) / (t1 - t0) : 0.0;
+            s[i] = (float)(p[k].second + f * (p[k + 1].second - p[k].second));
+        }
+    }
+    return add(s);
+}
+
+float ProfilePool::minFactor() const {
+    return minimum.empty() ? 1.0f : *min_element(minimum.begin(), minimum.end());
+}
+
+void assignHighwayProfiles(const Graph& g, ProfilePool& pool, TimeDependentCost& cost) {
+    const double H = 3600.0;
+    uint32_t arterial = pool.addPoints({ { 0 * H, 0.9 }, { 6 * H, 1.0 }, { 8 * H, 1.8 }, { 10 * H, 1.2 },
+                                         { 16 * H, 1.2 }, { 18 * H, 1.8 }, { 21 * H, 1.0 } });
+    uint32_t local = pool.addPoints({ { 0 * H, 0.95 }, { 6 * H, 1.0 }, { 8 * H, 1.3 }, { 10 * H, 1.05 },
+                                      { 16 * H, 1.05 }, { 18 * H, 1.3 }, { 21 * H, 1.0 } });
+    cost.profile.assign(g.numEdges(), 0);
+    for (uint32_t e = 0; e < g.numEdges(); e++) {
+        uint8_t hw = g.attr.highway.empty() ? (uint8_t)HW_UNKNOWN : g.attr.highway[e];
+        if (hw >= HW_MOTORWAY && hw <= HW_SECONDARY) cost.profile[e] = arterial;
+        else if (hw >= HW_TERTIARY && hw <= HW_RESIDENTIAL) cost.profile[e] = local;
+    }
+}
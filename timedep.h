@@ -0,0 +1,135 @@
+/*
+ timedep.h : ð뺰  ð (time-dependent routing)
+  - ProfilePool : Ϸ(86400) ֱ  (piecewise-linear)  Լ 
+                     (slots ) ǥ   =   +   (Ž/б )
+                       (ߺ )   鸸    
+  - TimeDependentCost :  e  ð t     ð = base[e] * (profile[e], t)
+  - assignHighwayProfiles() :  ޺ ⺻  ȥ   
+  - tdDijkstra() / tdAstar() :  ð ޾  ð ϴ ð  Ž
+     Լ FIFO (ʰ ؼ  ϴ  )  ؾ 
+  - tdHeuristic() : Ÿ / ְ ӵ x ü ּ   tdAstar  
+*/
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+#include "search.h"
+
+static constexpr double DAY_SECONDS = 86400.0;
+
+/* ================================
+   ProfilePool
+   -  p  ǥ : values[p * (slots+1) .. ],   ù   (ֱ )
+   - 0  ׻  1.0 (ð  )
+   ================================ */
+class ProfilePool {
+public:
+    explicit ProfilePool(uint32_t slots = 96);
+
+    uint32_t slots() const { return slots_; }
+    uint32_t size() const { return (uint32_t)(values.size() / (slots_ + 1)); }
+
+    // factors.size() == slots() : i °  = ð i * 86400 / slots     ȣ
+    uint32_t add(const std::vector<float>& factors);
+
+    // (ð(), )   slots  ٽ ǥ  add (ð  )
+    uint32_t addPoints(const std::vector<std::pair<double, double>>& points);
+
+    // ð t (, ֱ ̸ Ϸ  )  
+    float eval(uint32_t p, double t) const {
+        double day = t - std::floor(t * (1.0 / DAY_SECONDS)) * DAY_SECONDS;
+        double x = day * scale;
+        uint32_t i = (uint32_t)x;
+        i = i < slots_ ? i : slots_ - 1;
+        float f = (float)(x - i);
+        const float* s = &values[(size_t)p * (slots_ + 1) + i];
+        return s[0] + f * (s[1] - s[0]);
+    }
+
+    float minFactor(uint32_t p) const { return minimum[p]; }
+    float minFactor() const; // ü ּ (A* ѿ)
+
+private:
+    uint32_t slots_;
+    double scale;                // slots / DAY_SECONDS
+    std::vector<float> values;
+    std::vector<float> minimum;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> byHash; // ǥ ؽ   ȣ
+};
+
+/* ================================
+   TimeDependentCost :  (  ð,  ȣ)
+   - base   length /   ӵ (+  ȣ )
+   ================================ */
+struct TimeDependentCost {
+    const ProfilePool* pool = nullptr;
+    std::vector<double> base;     //    ð ()
+    std::vector<uint32_t> profile; //   ȣ (0 = )
+
+    TimeDependentCost() = default;
+    TimeDependentCost(const ProfilePool& pool, std::vector<double> base)
+        : pool(&pool), base(std::move(base)), profile(this->base.size(), 0) {}
+
+    double operator()(uint32_t, uint32_t e, double t) const { return base[e] * pool->eval(profile[e], t); }
+};
+
+//  ޺ ȥ ( 08 / 18 ,   )
+//  motorway ~ secondary : ִ 1.8 , tertiary ~ residential : ִ 1.3 ,  :  (0 )
+void assignHighwayProfiles(const Graph& g, ProfilePool& pool, TimeDependentCost& cost);
+
+//  :   ð(pool ּ ) maxSpeed   
+//   base[e] >= length[e] / maxSpeed   ( ϴ ̸ ״ )
+inline StraightLineHeuristic tdHeuristic(const Graph& g, const TimeDependentCost& cost, uint32_t goal, double maxSpeed) {
+    return StraightLineHeuristic(g, goal, cost.pool->minFactor() / maxSpeed);
+}
+
+/* =========================================================
+   ð  A* (h  0 ̸ Dijkstra)
+   - ws.dist(u) : u  ð, ȯ : goal  ð ( Ұ INF_DIST)
+   - cost(u, e, t) : ð t   e    ð
+   - h(u) : u  goal  ð  (  ð )
+   ========================================================= */
+template <class Queue, class Stats, class Cost, class Heuristic>
+double tdAstar(const Graph& g, BasicSearchWorkspace<Queue, Stats>& ws, uint32_t start, uint32_t goal, double departure,
+               Cost&& cost, Heuristic&& h) {
+    if (ws.size() != g.numNodes()) ws.resize(g.numNodes());
+    ws.reset();
+
+    auto& pq = ws.queue;
+    auto& st = ws.stats;
+    st.query();
+    ws.set(start, departure, INVALID_NODE);
+    pq.push(start, departure + h(start));
+    st.push(pq.size());
+
+    while (!pq.empty()) {
+        auto [key, u] = pq.pop();
+        double t = ws.dist(u);
+        if (key > t + h(u)) { st.stale(); continue; }
+        st.settle();
+        if (u == goal) break;
+
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+            uint32_t v = g.target[e];
+            double arrive = t + cost(u, e, t);
+            st.relax();
+            if (ws.dist(v) > arrive) {
+                ws.set(v, arrive, u);
+                pq.push(v, arrive + h(v));
+                st.push(pq.size());
+            }
+        }
+    }
+    return ws.dist(goal);
+}
+
+template <class Queue, class Stats, class Cost>
+double tdDijkstra(const Graph& g, BasicSearchWorkspace<Queue, Stats>& ws, uint32_t start, uint32_t goal, double departure,
+                  Cost&& cost) {
+    return tdAstar(g, ws, start, goal, departure, cost, ZeroPotential());
+}
@@ -0,0 +1,61 @@
+#include "turn.h"
+
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+static constexpr double DEG = 3.14159265358979323846 / 180.0;
+
+/* =========================================================
+      /   (CSR  ״)
+   ========================================================= */
+void TurnTable::build(const Graph& g) {
+    uint32_t m = g.numEdges();
+    source_.resize(m);
+    heading_.resize(m);
+    for (uint32_t u = 0; u < g.numNodes(); u++) {
+        for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); e++) {
+            uint32_t v = g.target[e];
+            source_[e] = u;
+            double dy = g.lat[v] - g.lat[u];
+            double dx = (g.lon[v] - g.lon[u]) * cos(g.lat[u] * DEG);
+            heading_[e] = (float)(atan2(dx, dy) / DEG);
+        }
+    }
+}
+
+bool TurnTable::set(const Graph& g, uint32_t from, uint32_t via, uint32_t to, double cost) {
+    bool found = false;
+    for (uint32_t k = g.inBegin(via); k < g.inEnd(via); k++) {
+        if (g.rSource[k] != from) continue;
+        uint32_t in = g.rEdge[k];
+        for (uint32_t out = g.edgeBegin(via); out < g.edgeEnd(via); out++) {
+            if (g.target[out] != to) continue;
+            override_[key(in, out)] = cost;
+            found = true;
+        }
+    }
+    return found;
+}
+
+int loadTurnRestrictions(const string& file, const Graph& g, TurnTable& turns) {
+    ifstream f(file);
+    if (!f) return -1;
+    if (!turns.built()) turns.build(g);
+
+    int applied = 0;
+    string line;
+    while (getline(f, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        istringstream in(line);
+        string a, b, c;
+        if (!(in >> a >> b >> c)) continue;
+        double cost;
+        if (!(in >> cost)) cost = INF_DIST;
+        uint32_t from = g.find(a), via = g.find(b), to = g.find(c);
+        if (from == INVALID_NODE || via == INVALID_NODE || to == INVALID_NODE) continue;
+        applied += turns.setPenalty(g, from, via, to, cost);
+    }
+    return applied;
+}
@@ -0,0 +1,151 @@
+/*
+ turn.h : ȸ  / ȸ  ݿϴ  (edge-based) Ž
+  - Ž  = " e   target[e]  "      ȸ  ޶
+  - line graph     :  e  target[e]    CSR  ٷ  (lazy)
+  - ߰   source(4B) + heading(4B)   ȸ ǥ
+  - ȸ  =  з(/ȸ/ȸ/) ⺻ +  ( Ǵ )
+*/
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "graph.h"
+#include "search.h"
+
+/* ================================
+   TurnCostModel :  з ⺻ ȸ  ( Ǵ ,    )
+   -    : ȸ  θ 
+   - INF_DIST ̸ 
+   ================================ */
+struct TurnCostModel {
+    double straight = 0.0;
+    double right = 5.0;
+    double left = 20.0;
+    double uTurn = INF_DIST;
+    double straightAngle = 30.0; // |ȸ| ̸  ()
+    double uTurnAngle = 170.0;   // |ȸ| ̸̻ 
+};
+
+/* ================================
+   TurnTable :   (in  out)  ȸ 
+   - build(g)  ,   ؽ ǥ (κ ȸ ⺻ 𵨷 )
+   ================================ */
+class TurnTable {
+public:
+    TurnCostModel model;
+
+    void build(const Graph& g);
+    bool built() const { return !source_.empty(); }
+
+    //  via  from  via  to ȸ  (  ),  ȸ̸ false
+    bool forbid(const Graph& g, uint32_t from, uint32_t via, uint32_t to) { return set(g, from, via, to, INF_DIST); }
+    bool setPenalty(const Graph& g, uint32_t from, uint32_t via, uint32_t to, double cost) {
+        return set(g, from, via, to, cost);
+    }
+    size_t overrides() const { return override_.size(); }
+
+    uint32_t source(uint32_t e) const { return source_[e]; }
+
+    //  in  out  Ż   (INF_DIST = )
+    double operator()(const Graph& g, uint32_t in, uint32_t out) const {
+        if (!override_.empty()) {
+            auto it = override_.find(key(in, out));
+            if (it != override_.end()) return it->second;
+        }
+        if (g.target[out] == source_[in]) return model.uTurn;
+        double d = heading_[out] - heading_[in];
+        if (d > 180) d -= 360;
+        if (d <= -180) d += 360;
+        double a = std::fabs(d);
+        if (a <= model.straightAngle) return model.straight;
+        if (a >= model.uTurnAngle) return model.uTurn;
+        return d > 0 ? model.right : model.left; //  ð  
+    }
+
+private:
+    static uint64_t key(uint32_t in, uint32_t out) { return ((uint64_t)in << 32) | out; }
+    bool set(const Graph& g, uint32_t from, uint32_t via, uint32_t to, double cost);
+
+    std::vector<uint32_t> source_; //   
+    std::vector<float> heading_;   //   (,  0 /  90)
+    std::unordered_map<uint64_t, double> override_;
+};
+
+/* =========================================================
+   ȸ   :  ٿ "from via to [cost]" (GraphML id)
+   - cost    (OSM no_left_turn ),   ȸ 
+   - '#'  ϴ  , ȯ : ݿ   (  -1)
+   ========================================================= */
+int loadTurnRestrictions(const std::string& file, const Graph& g, TurnTable& turns);
+
+/* =========================================================
+     Dijkstra (start  goal)
+   - ws    ũ  ( = ), prev =  
+   - start    ȸ   , target  goal   ó  
+   - *lastEdge : goal    (δ turnPath  )
+   ========================================================= */
+template <class Queue, class Stats, class Cost>
+double turnDijkstra(const Graph& g, BasicSearchWorkspace<Queue, Stats>& ws, uint32_t start, uint32_t goal, Cost&& cost,
+                    const TurnTable& turns, uint32_t* lastEdge) {
+    if (lastEdge) *lastEdge = INVALID_EDGE;
+    if (start == goal) return 0;
+    if (ws.size() != g.numEdges()) ws.resize(g.numEdges());
+    ws.reset();
+
+    auto& pq = ws.queue;
+    auto& st = ws.stats;
+    st.query();
+    for (uint32_t e = g.edgeBegin(start); e < g.edgeEnd(start); e++) {
+        double d = cost(start, e);
+        if (ws.dist(e) > d) {
+            ws.set(e, d, INVALID_EDGE);
+            pq.push(e, d);
+            st.push(pq.size());
+        }
+    }
+
+    while (!pq.empty()) {
+        auto [cd, e] = pq.pop();
+        if (cd > ws.dist(e)) { st.stale(); continue; }
+        st.settle();
+        uint32_t v = g.target[e];
+        if (v == goal) {
+            if (lastEdge) *lastEdge = e;
+            return cd;
+        }
+
+        for (uint32_t f = g.edgeBegin(v); f < g.edgeEnd(v); f++) {
+            double t = turns(g, e, f);
+            if (t >= INF_DIST) continue;
+            double nd = cd + t + cost(v, f);
+            st.relax();
+            if (ws.dist(f) > nd) {
+                ws.set(f, nd, e);
+                pq.push(f, nd);
+                st.push(pq.size());
+            }
+        }
+    }
+    return INF_DIST;
+}
+
+//  turnDijkstra     ( 带     )
+template <class Queue, class Stats>
+void turnPath(const Graph& g, const BasicSearchWorkspace<Queue, Stats>& ws, const TurnTable& turns, uint32_t lastEdge,
+              std::vector<uint32_t>& out) {
+    out.clear();
+    if (lastEdge == INVALID_EDGE) return;
+    uint32_t e = lastEdge;
+    out.push_back(g.target[e]);
+    for (;;) {
+        uint32_t p = ws.prev(e);
+        out.push_back(turns.source(e));
+        if (p == INVALID_EDGE) break;
+        e = p;
+    }
+    std::reverse(out.begin(), out.end());
+}